@@ -13,6 +13,41 @@
 #include <filesystem>
 #include <memory>
 #include <random>
+#include <string_view>
+#include <cctype>
+#include <unordered_set>
+#include <deque>
+#include <bitset>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <csignal>
+#include <atomic>
+#include <array>
+#include <limits>
+#include <functional>
+#include <unistd.h>
+
+// AVX2 scoring kernel, picked at run time; build with -DLFB_DISABLE_SIMD
+// to keep only the scalar one
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(LFB_DISABLE_SIMD)
+#include <immintrin.h>
+#define LFB_HAVE_AVX2 1
+#endif
 
 /**
  * Lost and Found Bot - C++ Backend (No SQL)
@@ -29,934 +64,6608 @@ private:
     const std::string LOST_ITEMS_FILE = DATA_DIR + "/lost_items.json";
     const std::string FOUND_ITEMS_FILE = DATA_DIR + "/found_items.json";
     const std::string LOCATIONS_FILE = DATA_DIR + "/locations.json";
+    const std::string LOST_SNAPSHOT_FILE = DATA_DIR + "/lost_items.snap";
+    const std::string FOUND_SNAPSHOT_FILE = DATA_DIR + "/found_items.snap";
+    const std::string JOURNAL_FILE = DATA_DIR + "/journal.log";
+    const std::string COMPACTING_JOURNAL_FILE = DATA_DIR + "/journal.log.compacting";
+    const std::string LOST_ARCHIVE_FILE = DATA_DIR + "/lost_archive.snap";
+    const std::string FOUND_ARCHIVE_FILE = DATA_DIR + "/found_archive.snap";
+    const std::string ARCHIVE_ROLLUPS_FILE = DATA_DIR + "/archive_rollups.dat";
+
+    // Write and prefer the binary snapshots alongside the JSON files
+    static constexpr bool BINARY_SNAPSHOTS_ENABLED = true;
+
+    // Journal (write-ahead log) tuning
+    static constexpr int JOURNAL_GROUP_COMMIT_US = 200;        // Wait for more records before an fsync
+    static constexpr size_t JOURNAL_COMPACT_THRESHOLD = 1000;  // Records before compaction
+
+    // Instrumentation; build with -DLFB_DISABLE_METRICS to compile it out
+#ifdef LFB_DISABLE_METRICS
+    static constexpr bool METRICS_ENABLED = false;
+#else
+    static constexpr bool METRICS_ENABLED = true;
+#endif
+
+    // Counters and HDR-style histograms (8 log-linear sub-buckets per
+    // power of two, so values are kept within 12.5%). Each thread writes
+    // its own shard without locks or read-modify-write atomics; a dump sums
+    // the shards. Shards outlive their threads, so no counts are lost.
+    class Metrics {
+    public:
+        enum Counter {
+            SEARCHES,
+            ITEMS_SCORED,
+            SCORE_CALLS,
+            ITEMS_LOADED,
+            BYTES_PARSED,
+            ITEMS_SAVED,
+            COUNTER_COUNT
+        };
 
-    // Location data structure
-    struct Location {
-        std::string name;
-        std::string roomNumber;
-        std::string description;
-    };
+        enum Histogram {
+            LOAD_ITEMS,            // ns
+            PARSE_FILE,            // ns
+            SAVE_ITEMS,            // ns
+            SEARCH,                // ns
+            SEARCH_SCORING,        // ns
+            CANDIDATES_PER_SEARCH, // items
+            REMATCH,               // ns
+            HISTOGRAM_COUNT
+        };
 
-    std::vector<Location> predefinedLocations;
+        static void add(Counter counter, uint64_t amount = 1) {
+            if (METRICS_ENABLED) {
+                bump(local().counters[counter], amount);
+            }
+        }
 
-    // Item category enum
-    enum class ItemCategory {
-        SMARTPHONE,
-        LAPTOP,
-        TABLET,
-        HEADPHONE,
-        SMARTWATCH,
-        WALLET,
-        KEYS,
-        BAG,
-        OTHER
-    };
+        static void record(Histogram histogram, uint64_t value) {
+            if (METRICS_ENABLED) {
+                Shard& shard = local();
+                bump(shard.buckets[histogram][bucketOf(value)], 1);
+                bump(shard.sums[histogram], value);
+            }
+        }
 
-    // Category name mapping
-    std::map<ItemCategory, std::string> categoryNames = {
-        {ItemCategory::SMARTPHONE, "Smartphone"},
-        {ItemCategory::LAPTOP, "Laptop"},
-        {ItemCategory::TABLET, "Tablet"},
-        {ItemCategory::HEADPHONE, "Headphone"},
-        {ItemCategory::SMARTWATCH, "Smartwatch"},
-        {ItemCategory::WALLET, "Wallet"},
-        {ItemCategory::KEYS, "Keys"},
-        {ItemCategory::BAG, "Bag"},
-        {ItemCategory::OTHER, "Other"}
-    };
+        // Records the nanoseconds from construction to destruction
+        class Timer {
+        public:
+            explicit Timer(Histogram histogram) : histogram(histogram) {
+                if (METRICS_ENABLED) {
+                    start = std::chrono::steady_clock::now();
+                }
+            }
 
-    // Reverse mapping for string to category
-    std::map<std::string, ItemCategory> categoryByName;
+            ~Timer() {
+                if (METRICS_ENABLED) {
+                    record(histogram, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now() - start).count());
+                }
+            }
 
-    // Category-specific attributes
-    std::map<ItemCategory, std::vector<std::string>> categoryAttributes;
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
 
-    // Data structures for items
-    struct Item {
-        std::string id;
-        std::string personName;
-        std::string contactInfo;
-        std::string category;
-        std::string eventTime; // When lost or found
-        std::string location;
-        std::string reportTime; // When reported
-        std::map<std::string, std::string> details;
-        std::string additionalInfo;
-        std::string status;
-    };
+        private:
+            Histogram histogram;
+            std::chrono::steady_clock::time_point start;
+        };
 
-    std::vector<Item> lostItems;
-    std::vector<Item> foundItems;
+        // Prometheus text exposition format: counters, and each histogram
+        // as a summary with quantiles (durations in seconds)
+        static std::string prometheus() {
+            Totals totals = collect();
+            std::ostringstream out;
+            for (size_t i = 0; i < COUNTER_COUNT; i++) {
+                out << "# TYPE lfb_" << COUNTER_NAMES[i] << "_total counter\n"
+                    << "lfb_" << COUNTER_NAMES[i] << "_total " << totals.counters[i] << "\n";
+            }
+            for (size_t i = 0; i < HISTOGRAM_COUNT; i++) {
+                const std::string name = "lfb_" + histogramName(i);
+                const double scale = isDuration(i) ? 1e-9 : 1.0;
+                out << "# TYPE " << name << " summary\n";
+                for (double q : {0.5, 0.9, 0.99, 0.999}) {
+                    out << name << "{quantile=\"" << q << "\"} " << quantile(totals.buckets[i], q) * scale << "\n";
+                }
+                out << name << "_sum " << totals.sums[i] * scale << "\n"
+                    << name << "_count " << count(totals.buckets[i]) << "\n";
+            }
+            return out.str();
+        }
 
-    // Initialize category attributes
-    void initCategoryAttributes() {
-        // Smartphone attributes
-        categoryAttributes[ItemCategory::SMARTPHONE] = {
-            "brand", "model", "color", "case_description", "has_lock_screen"
-        };
+        static std::string json() {
+            Totals totals = collect();
+            std::ostringstream out;
+            out << "{\"counters\":{";
+            for (size_t i = 0; i < COUNTER_COUNT; i++) {
+                out << (i > 0 ? "," : "") << "\"" << COUNTER_NAMES[i] << "\":" << totals.counters[i];
+            }
+            out << "},\"histograms\":{";
+            for (size_t i = 0; i < HISTOGRAM_COUNT; i++) {
+                const double scale = isDuration(i) ? 1e-9 : 1.0;
+                out << (i > 0 ? "," : "") << "\"" << histogramName(i) << "\":{\"count\":"
+                    << count(totals.buckets[i]) << ",\"sum\":" << totals.sums[i] * scale;
+                for (double q : {0.5, 0.9, 0.99, 0.999}) {
+                    out << ",\"p" << q * 100 << "\":" << quantile(totals.buckets[i], q) * scale;
+                }
+                out << ",\"max\":" << quantile(totals.buckets[i], 1.0) * scale << "}";
+            }
+            out << "}}";
+            return out.str();
+        }
 
-        // Laptop attributes
-        categoryAttributes[ItemCategory::LAPTOP] = {
-            "brand", "model", "color", "has_stickers", "laptop_bag"
-        };
+    private:
+        static constexpr size_t SUB_BUCKETS = 8;
+        static constexpr size_t BUCKET_COUNT = 62 * SUB_BUCKETS;
 
-        // Headphone attributes
-        categoryAttributes[ItemCategory::HEADPHONE] = {
-            "brand", "model", "color", "wired_wireless", "has_case"
-        };
+        static constexpr const char* COUNTER_NAMES[COUNTER_COUNT] = {
+            "searches", "items_scored", "score_calls", "items_loaded", "bytes_parsed", "items_saved"};
+        static constexpr const char* HISTOGRAM_NAMES[HISTOGRAM_COUNT] = {
+            "load_items", "parse_file", "save_items", "search", "search_scoring", "candidates_per_search",
+            "rematch"};
 
-        // Tablet attributes
-        categoryAttributes[ItemCategory::TABLET] = {
-            "brand", "model", "color", "has_case", "screen_size"
+        struct Shard {
+            std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{};
+            std::array<std::array<std::atomic<uint64_t>, BUCKET_COUNT>, HISTOGRAM_COUNT> buckets{};
+            std::array<std::atomic<uint64_t>, HISTOGRAM_COUNT> sums{};
         };
 
-        // Smartwatch attributes
-        categoryAttributes[ItemCategory::SMARTWATCH] = {
-            "brand", "model", "color", "band_type"
+        struct Totals {
+            std::array<uint64_t, COUNTER_COUNT> counters{};
+            std::array<std::array<uint64_t, BUCKET_COUNT>, HISTOGRAM_COUNT> buckets{};
+            std::array<uint64_t, HISTOGRAM_COUNT> sums{};
         };
 
-        // Default attributes for other categories
-        std::vector<std::string> defaultAttrs = {
-            "color", "size", "distinguishing_features"
-        };
+        // Only the owning thread writes a shard, so a plain load and store
+        // is enough; readers may see a slightly stale value
+        static void bump(std::atomic<uint64_t>& value, uint64_t amount) {
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
 
-        categoryAttributes[ItemCategory::WALLET] = defaultAttrs;
-        categoryAttributes[ItemCategory::KEYS] = defaultAttrs;
-        categoryAttributes[ItemCategory::BAG] = defaultAttrs;
-        categoryAttributes[ItemCategory::OTHER] = defaultAttrs;
+        static bool isDuration(size_t histogram) {
+            return histogram != CANDIDATES_PER_SEARCH;
+        }
 
-        // Initialize reverse mapping
-        for (const auto& pair : categoryNames) {
-            categoryByName[pair.second] = pair.first;
+        static std::string histogramName(size_t histogram) {
+            return std::string(HISTOGRAM_NAMES[histogram]) + (isDuration(histogram) ? "_seconds" : "");
         }
-    }
 
-    // Get user input with prompt
-    std::string getInput(const std::string& prompt) {
-        std::string input;
-        std::cout << prompt;
-        std::getline(std::cin, input);
-        return input;
-    }
+        // Values below 8 get a bucket each; above that, 8 per power of two
+        static size_t bucketOf(uint64_t value) {
+            if (value < SUB_BUCKETS) {
+                return static_cast<size_t>(value);
+            }
+            const int exponent = 63 - __builtin_clzll(value);
+            return (exponent - 2) * SUB_BUCKETS + ((value >> (exponent - 3)) & (SUB_BUCKETS - 1));
+        }
 
-    // Get integer input with validation
-    int getIntInput(const std::string& prompt, int min, int max) {
-        int input;
-        std::string line;
-        bool valid = false;
+        // Largest value that falls in a bucket
+        static uint64_t bucketLimit(size_t bucket) {
+            if (bucket < SUB_BUCKETS) {
+                return bucket;
+            }
+            const int exponent = static_cast<int>(bucket / SUB_BUCKETS) + 2;
+            const uint64_t low = (SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 3);
+            return low + (uint64_t(1) << (exponent - 3)) - 1;
+        }
 
-        while (!valid) {
-            std::cout << prompt;
-            std::getline(std::cin, line);
+        static uint64_t count(const std::array<uint64_t, BUCKET_COUNT>& buckets) {
+            uint64_t total = 0;
+            for (uint64_t n : buckets) {
+                total += n;
+            }
+            return total;
+        }
 
-            try {
-                input = std::stoi(line);
-                if (input >= min && input <= max) {
-                    valid = true;
-                } else {
-                    std::cout << "Please enter a number between " << min << " and " << max << std::endl;
+        static double quantile(const std::array<uint64_t, BUCKET_COUNT>& buckets, double q) {
+            const uint64_t total = count(buckets);
+            if (total == 0) {
+                return 0;
+            }
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * total)));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKET_COUNT; i++) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    return static_cast<double>(bucketLimit(i));
                 }
-            } catch (const std::exception& e) {
-                std::cout << "Invalid input. Please enter a number." << std::endl;
             }
+            return static_cast<double>(bucketLimit(BUCKET_COUNT - 1));
         }
 
-        return input;
-    }
-
-    // Get item category from user
-    ItemCategory getItemCategory() {
-        std::cout << "\nSelect item category:" << std::endl;
-        int i = 1;
-        std::map<int, ItemCategory> categoryMap;
+        // Shards of the live threads, plus the counts of threads that have
+        // exited, so memory stays bounded by the live thread count
+        struct Registry {
+            std::mutex mutex;
+            std::vector<Shard*> shards;
+            Totals retired;
+        };
 
-        for (const auto& category : categoryNames) {
-            std::cout << i << ". " << category.second << std::endl;
-            categoryMap[i++] = category.first;
+        static Registry& registry() {
+            static Registry registry;
+            return registry;
         }
 
-        int choice = getIntInput("Enter category number: ", 1, categoryNames.size());
-        return categoryMap[choice];
-    }
+        // A thread's shard; on thread exit its counts fold into the retired
+        // totals and it is freed
+        struct ShardOwner {
+            std::unique_ptr<Shard> shard = std::make_unique<Shard>();
 
-    // Get timestamp from user input
-    std::string getDateTime(const std::string& prompt) {
-        std::string dateTimeStr;
-        bool validFormat = false;
+            ShardOwner() {
+                Registry& all = registry();
+                std::lock_guard<std::mutex> lock(all.mutex);
+                all.shards.push_back(shard.get());
+            }
 
-        while (!validFormat) {
-            dateTimeStr = getInput(prompt + " (YYYY-MM-DD HH:MM): ");
+            ~ShardOwner() {
+                Registry& all = registry();
+                std::lock_guard<std::mutex> lock(all.mutex);
+                addShard(all.retired, *shard);
+                all.shards.erase(std::find(all.shards.begin(), all.shards.end(), shard.get()));
+            }
+        };
 
-            // Simple format validation
-            if (dateTimeStr.length() == 16 &&
-                dateTimeStr[4] == '-' && dateTimeStr[7] == '-' &&
-                dateTimeStr[10] == ' ' && dateTimeStr[13] == ':') {
-                validFormat = true;
-            } else {
-                std::cout << "Invalid format. Please use YYYY-MM-DD HH:MM format." << std::endl;
+        static Shard& local() {
+            thread_local ShardOwner owner;
+            return *owner.shard;
+        }
+
+        static void addShard(Totals& totals, const Shard& shard) {
+            for (size_t i = 0; i < COUNTER_COUNT; i++) {
+                totals.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+            }
+            for (size_t i = 0; i < HISTOGRAM_COUNT; i++) {
+                for (size_t b = 0; b < BUCKET_COUNT; b++) {
+                    totals.buckets[i][b] += shard.buckets[i][b].load(std::memory_order_relaxed);
+                }
+                totals.sums[i] += shard.sums[i].load(std::memory_order_relaxed);
             }
         }
 
-        return dateTimeStr;
-    }
+        static Totals collect() {
+            Registry& all = registry();
+            std::lock_guard<std::mutex> lock(all.mutex);
+            Totals totals = all.retired;
+            for (const Shard* shard : all.shards) {
+                addShard(totals, *shard);
+            }
+            return totals;
+        }
+    };
 
-    // Get item details based on category
-    std::map<std::string, std::string> getItemDetails(ItemCategory category) {
-        std::map<std::string, std::string> details;
-        std::cout << "\nPlease provide details about the " << categoryNames[category] << ":" << std::endl;
+    // Location data structure. Predefined locations form a building /
+    // floor / room hierarchy; flat records are their own building.
+    struct Location {
+        std::string name;
+        std::string roomNumber;
+        std::string description;
+        std::string building;
+        std::string floor;
 
-        for (const auto& attribute : categoryAttributes[category]) {
-            // Format attribute name for display (replace underscores with spaces)
-            std::string displayName = attribute;
-            std::replace(displayName.begin(), displayName.end(), '_', ' ');
+        // The text stored on items reported at this location
+        std::string label() const {
+            return roomNumber.empty() ? name : name + " (Room " + roomNumber + ")";
+        }
+    };
 
-            // Capitalize first letter
-            if (!displayName.empty()) {
-                displayName[0] = std::toupper(displayName[0]);
-            }
+    std::vector<Location> predefinedLocations;
 
-            std::string value = getInput(displayName + ": ");
-            details[attribute] = value;
-        }
+    // Item category enum
+    enum class ItemCategory {
+        SMARTPHONE,
+        LAPTOP,
+        TABLET,
+        HEADPHONE,
+        SMARTWATCH,
+        WALLET,
+        KEYS,
+        BAG,
+        OTHER
+    };
 
-        return details;
-    }
+    static constexpr size_t CATEGORY_COUNT = 9;
+    static constexpr size_t MAX_CATEGORY_ATTRIBUTES = 5;
 
-    // Generate a random ID
-    std::string generateId() {
-        const std::string chars = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
-        std::random_device rd;
-        std::mt19937 generator(rd());
-        std::uniform_int_distribution<> distribution(0, chars.size() - 1);
+    // A category's display name and the attributes asked for when an item
+    // of it is reported
+    struct CategorySchema {
+        std::string_view name;
+        std::array<std::string_view, MAX_CATEGORY_ATTRIBUTES> attributes;
+        size_t attributeCount;
 
-        std::string id;
-        for (int i = 0; i < 10; ++i) {
-            id += chars[distribution(generator)];
-        }
+        const std::string_view* begin() const { return attributes.data(); }
+        const std::string_view* end() const { return attributes.data() + attributeCount; }
+    };
 
-        return id;
+    // Category schemas, indexed by ItemCategory
+    static constexpr std::array<CategorySchema, CATEGORY_COUNT> CATEGORY_SCHEMAS = {{
+        {"Smartphone", {"brand", "model", "color", "case_description", "has_lock_screen"}, 5},
+        {"Laptop", {"brand", "model", "color", "has_stickers", "laptop_bag"}, 5},
+        {"Tablet", {"brand", "model", "color", "has_case", "screen_size"}, 5},
+        {"Headphone", {"brand", "model", "color", "wired_wireless", "has_case"}, 5},
+        {"Smartwatch", {"brand", "model", "color", "band_type"}, 4},
+        {"Wallet", {"color", "size", "distinguishing_features"}, 3},
+        {"Keys", {"color", "size", "distinguishing_features"}, 3},
+        {"Bag", {"color", "size", "distinguishing_features"}, 3},
+        {"Other", {"color", "size", "distinguishing_features"}, 3},
+    }};
+
+    static const CategorySchema& categorySchema(ItemCategory category) {
+        return CATEGORY_SCHEMAS[static_cast<size_t>(category)];
     }
 
-    // Get current timestamp as string
-    std::string getCurrentTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto now_c = std::chrono::system_clock::to_time_t(now);
-
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&now_c), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+    static std::string_view categoryName(ItemCategory category) {
+        return categorySchema(category).name;
     }
 
-    // Load predefined locations from JSON file
-    void loadLocations() {
-        predefinedLocations.clear();
+    // Item status enum
+    enum class ItemStatus {
+        OPEN,
+        CLOSED,
+        MATCHED
+    };
 
-        std::ifstream file(LOCATIONS_FILE);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open locations file: " << LOCATIONS_FILE << std::endl;
-            return;
-        }
+    // Status name mapping
+    static inline const std::map<ItemStatus, std::string> statusNames = {
+        {ItemStatus::OPEN, "OPEN"},
+        {ItemStatus::CLOSED, "CLOSED"},
+        {ItemStatus::MATCHED, "MATCHED"}
+    };
 
-        std::string line;
-        std::string content;
+    // Character trigrams of a value hashed into a 256-bit set, for fuzzy
+    // comparison by popcount of the intersection
+    struct TrigramSignature {
+        std::bitset<256> bits;
+        uint16_t count = 0;  // Bits set; 0 for blank values
+    };
+
+    // Interned lowercase strings. Symbol 0 is the empty string; symbol text
+    // lives in a deque so views into it stay valid as the table grows. Each
+    // symbol's trigram signature is computed once, when it is interned.
+    class SymbolTable {
+    public:
+        static constexpr uint32_t NO_SYMBOL = UINT32_MAX;
 
-        while (std::getline(file, line)) {
-            content += line;
+        SymbolTable() {
+            intern("");
         }
 
-        file.close();
+        // Copies rebuild the lookup map, whose keys view this table's strings
+        SymbolTable(const SymbolTable& other) : strings(other.strings), signatures(other.signatures) {
+            rebuildIds();
+        }
 
-        // Simple JSON parsing
-        if (content.empty() || content == "[]") {
-            return;
+        SymbolTable& operator=(const SymbolTable& other) {
+            if (this != &other) {
+                strings = other.strings;
+                signatures = other.signatures;
+                rebuildIds();
+            }
+            return *this;
         }
 
-        // Strip outer brackets
-        content = content.substr(1, content.length() - 2);
+        SymbolTable(SymbolTable&&) = default;
+        SymbolTable& operator=(SymbolTable&&) = default;
 
-        // Split by location
-        std::vector<std::string> locationStrings;
-        int braceDepth = 0;
-        std::string currentLocation;
+        // Return the symbol for text, adding it if needed
+        uint32_t intern(std::string_view text) {
+            auto it = ids.find(text);
+            if (it != ids.end()) {
+                return it->second;
+            }
 
-        for (char c : content) {
-            if (c == '{') {
-                braceDepth++;
-                currentLocation += c;
-            } else if (c == '}') {
-                braceDepth--;
-                currentLocation += c;
+            uint32_t id = static_cast<uint32_t>(strings.size());
+            strings.emplace_back(text);
+            signatures.push_back(trigramSignature(text));
+            ids.emplace(strings.back(), id);
+            return id;
+        }
 
-                if (braceDepth == 0) {
-                    locationStrings.push_back(currentLocation);
-                    currentLocation = "";
-                    // Skip comma and space after item
-                    braceDepth = -1;
-                }
-            } else if (braceDepth == -1) {
-                if (c == ',') {
-                    braceDepth = 0;
-                }
-            } else {
-                currentLocation += c;
-            }
+        // Return the symbol for text, or NO_SYMBOL if it was never interned
+        uint32_t find(std::string_view text) const {
+            auto it = ids.find(text);
+            return it != ids.end() ? it->second : NO_SYMBOL;
         }
 
-        // Parse each location
-        for (const auto& locStr : locationStrings) {
-            Location loc;
-            loc.name = extractJsonValue(locStr, "name");
-            loc.roomNumber = extractJsonValue(locStr, "roomNumber");
-            loc.description = extractJsonValue(locStr, "description");
-            predefinedLocations.push_back(loc);
+        std::string_view text(uint32_t id) const {
+            return strings[id];
         }
-    }
 
-    // Get location from user with predefined options
-    std::string getLocation() {
-        std::cout << "\nSelect location:" << std::endl;
-        std::cout << "1. Choose from predefined locations" << std::endl;
-        std::cout << "2. Enter custom location" << std::endl;
+        const TrigramSignature& signature(uint32_t id) const {
+            return signatures[id];
+        }
 
-        int choice = getIntInput("Enter your choice: ", 1, 2);
+        size_t size() const {
+            return strings.size();
+        }
 
-        if (choice == 1) {
-            if (predefinedLocations.empty()) {
-                std::cout << "No predefined locations available. Please enter a custom location." << std::endl;
-                return getInput("Enter location: ");
-            }
+    private:
+        std::deque<std::string> strings;
+        std::vector<TrigramSignature> signatures;
+        std::unordered_map<std::string_view, uint32_t> ids;
 
-            std::cout << "\nAvailable locations:" << std::endl;
-            for (size_t i = 0; i < predefinedLocations.size(); i++) {
-                std::cout << (i + 1) << ". " << predefinedLocations[i].name;
-                if (!predefinedLocations[i].roomNumber.empty()) {
-                    std::cout << " (Room " << predefinedLocations[i].roomNumber << ")";
-                }
-                std::cout << std::endl;
+        void rebuildIds() {
+            ids.clear();
+            for (size_t i = 0; i < strings.size(); i++) {
+                ids.emplace(strings[i], static_cast<uint32_t>(i));
             }
+        }
+    };
 
-            int locChoice = getIntInput("Select location: ", 1, predefinedLocations.size());
-            const Location& selectedLoc = predefinedLocations[locChoice - 1];
+    // Event time of an item whose eventTime could not be parsed
+    static constexpr int64_t NO_EVENT_TIME = INT64_MIN;
 
-            std::string locationStr = selectedLoc.name;
-            if (!selectedLoc.roomNumber.empty()) {
-                locationStr += " (Room " + selectedLoc.roomNumber + ")";
-            }
+    // Location id of an item reported at a custom location
+    static constexpr uint16_t NO_LOCATION = UINT16_MAX;
 
-            return locationStr;
-        } else {
-            return getInput("Enter location: ");
-        }
-    }
+    // One detail in normalized form: attribute id and interned lowercase value
+    struct NormalizedDetail {
+        uint8_t attribute;
+        uint32_t value;
+    };
 
-    // Initialize data directory and files
-    void initDataStorage() {
-        try {
-            // Create data directory if it doesn't exist
-            if (!std::filesystem::exists(DATA_DIR)) {
-                std::filesystem::create_directory(DATA_DIR);
+    // Bump allocator for item text. Strings are appended to large chunks
+    // that are freed together, when the last item viewing them goes away.
+    class StringArena {
+    public:
+        explicit StringArena(size_t chunkSize = 1 << 20) : chunkSize(chunkSize) {}
+        StringArena(const StringArena&) = delete;
+        StringArena& operator=(const StringArena&) = delete;
+
+        // Copy text into the arena; the view stays valid as long as it does
+        std::string_view store(std::string_view text) {
+            if (text.empty()) {
+                return {};
             }
-
-            // Create files if they don't exist
-            if (!std::filesystem::exists(LOST_ITEMS_FILE)) {
-                std::ofstream file(LOST_ITEMS_FILE);
-                file << "[]";
-                file.close();
+            if (text.size() > remaining) {
+                remaining = std::max(chunkSize, text.size());
+                chunks.emplace_back(new char[remaining]);
+                next = chunks.back().get();
             }
+            char* out = next;
+            std::memcpy(out, text.data(), text.size());
+            next += text.size();
+            remaining -= text.size();
+            return std::string_view(out, text.size());
+        }
 
-            if (!std::filesystem::exists(FOUND_ITEMS_FILE)) {
-                std::ofstream file(FOUND_ITEMS_FILE);
-                file << "[]";
-                file.close();
-            }
+    private:
+        size_t chunkSize;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char* next = nullptr;
+        size_t remaining = 0;
+    };
 
-            if (!std::filesystem::exists(LOCATIONS_FILE)) {
-                std::ofstream file(LOCATIONS_FILE);
-                file << "[]";
-                file.close();
+    // Item details: a flat list sorted by key. Up to INLINE_DETAILS entries
+    // live in the list itself, which covers every category's attributes.
+    class DetailList {
+    public:
+        using value_type = std::pair<std::string_view, std::string_view>;
+        using const_iterator = const value_type*;
+        static constexpr size_t INLINE_DETAILS = 5;
+
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + size(); }
+        size_t size() const { return spilled.empty() ? count : spilled.size(); }
+        bool empty() const { return size() == 0; }
+
+        const_iterator find(std::string_view key) const {
+            const_iterator it = lowerBound(key);
+            return (it != end() && it->first == key) ? it : end();
+        }
+
+        // Insert or replace a detail; the views must outlive the list
+        void set(std::string_view key, std::string_view value) {
+            const size_t pos = lowerBound(key) - begin();
+            if (pos < size() && begin()[pos].first == key) {
+                mutableData()[pos].second = value;
+                return;
             }
 
-            // Load existing data
-            loadItems();
-            loadLocations();
-        } catch (const std::exception& e) {
-            std::cerr << "Error initializing data storage: " << e.what() << std::endl;
+            if (spilled.empty() && count < INLINE_DETAILS) {
+                std::move_backward(fixed.begin() + pos, fixed.begin() + count, fixed.begin() + count + 1);
+                fixed[pos] = value_type(key, value);
+                count++;
+                return;
+            }
+            if (spilled.empty()) {
+                spilled.assign(fixed.begin(), fixed.begin() + count);
+            }
+            spilled.insert(spilled.begin() + pos, value_type(key, value));
         }
-    }
 
-    // Load items from storage files
-    void loadItems() {
-        lostItems.clear();
-        foundItems.clear();
+    private:
+        std::array<value_type, INLINE_DETAILS> fixed{};
+        uint8_t count = 0;
+        std::vector<value_type> spilled;  // Used instead of fixed once it is full
 
-        loadItemsFromFile(LOST_ITEMS_FILE, lostItems);
-        loadItemsFromFile(FOUND_ITEMS_FILE, foundItems);
-    }
+        const value_type* data() const { return spilled.empty() ? fixed.data() : spilled.data(); }
+        value_type* mutableData() { return spilled.empty() ? fixed.data() : spilled.data(); }
 
-    // Load items from a specific file
-    void loadItemsFromFile(const std::string& filename, std::vector<Item>& items) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file: " << filename << std::endl;
-            return;
+        const_iterator lowerBound(std::string_view key) const {
+            return std::lower_bound(begin(), end(), key,
+                                    [](const value_type& detail, std::string_view k) { return detail.first < k; });
         }
+    };
 
-        std::string line;
-        std::string content;
-
-        while (std::getline(file, line)) {
-            content += line;
+    // Data structures for items. Text fields are views into the arena held
+    // by text: items loaded together share one arena (so copies of them
+    // are cheap), and items built one at a time get a small one of their
+    // own. Set text through set/setDetail, which copy the value.
+    struct Item {
+        std::string_view id;
+        std::string_view personName;
+        std::string_view contactInfo;
+        ItemCategory category = ItemCategory::OTHER;
+        std::string_view eventTime; // When lost or found
+        std::string_view location;
+        std::string_view reportTime; // When reported
+        DetailList details;
+        std::string_view additionalInfo;
+        ItemStatus status = ItemStatus::OPEN;
+        std::shared_ptr<StringArena> text;
+
+        void set(std::string_view Item::*field, std::string_view value) {
+            this->*field = writableText().store(value);
         }
 
-        file.close();
-
-        // Simple JSON parsing (in a real application, use a proper JSON library)
-        if (content.empty() || content == "[]") {
-            return;
+        void setDetail(std::string_view key, std::string_view value) {
+            StringArena& arena = writableText();
+            details.set(arena.store(key), arena.store(value));
         }
 
-        // Strip outer brackets
-        content = content.substr(1, content.length() - 2);
-
-        // Split by item
-        std::vector<std::string> itemStrings;
-        int braceDepth = 0;
-        std::string currentItem;
-
-        for (char c : content) {
-            if (c == '{') {
-                braceDepth++;
-                currentItem += c;
-            } else if (c == '}') {
-                braceDepth--;
-                currentItem += c;
-
-                if (braceDepth == 0) {
-                    itemStrings.push_back(currentItem);
-                    currentItem = "";
-                    // Skip comma and space after item
-                    braceDepth = -1;
+        // An arena only this item uses, so appending to it cannot race
+        // with anything reading another item. An item sharing its arena
+        // first copies its text into one of its own.
+        StringArena& writableText() {
+            if (!text || text.use_count() > 1) {
+                auto own = std::make_shared<StringArena>(256);
+                for (auto field : TEXT_FIELDS) {
+                    this->*field = own->store(this->*field);
                 }
-            } else if (braceDepth == -1) {
-                if (c == ',') {
-                    braceDepth = 0;
+                DetailList copied;
+                for (const auto& detail : details) {
+                    copied.set(own->store(detail.first), own->store(detail.second));
                 }
-            } else {
-                currentItem += c;
+                details = std::move(copied);
+                text = std::move(own);
             }
+            return *text;
         }
 
-        // Parse each item
-        for (const auto& itemStr : itemStrings) {
-            Item item = parseItemJson(itemStr);
-            items.push_back(item);
-        }
-    }
+        static constexpr std::string_view Item::*TEXT_FIELDS[] = {
+            &Item::id, &Item::personName, &Item::contactInfo, &Item::eventTime,
+            &Item::location, &Item::reportTime, &Item::additionalInfo};
+
+        // Normalized form used for matching, filled in by normalizeItem
+        int64_t eventMinute = NO_EVENT_TIME;  // Minutes since 1970-01-01 00:00
+        uint32_t locationSymbol = 0;
+        uint16_t locationId = NO_LOCATION;    // Predefined location, if any
+        std::vector<NormalizedDetail> normalizedDetails; // Sorted by attribute
+        std::array<uint32_t, MAX_CATEGORY_ATTRIBUTES> schemaValues{};  // Value symbol per schema attribute
+        bool extraDetails = false;            // Has details outside its schema
+    };
 
-    // Parse a JSON string into an Item (simplified parser)
-    Item parseItemJson(const std::string& json) {
-        Item item;
+    // A search in normalized form. Values that were never interned cannot
+    // equal any stored value, so they carry their text for partial matching.
+    struct MatchQuery {
+        struct Term {
+            uint8_t attribute;
+            uint32_t value;      // SymbolTable::NO_SYMBOL if not interned
+            std::string text;    // Lowercase value
+            TrigramSignature signature;
+        };
 
-        // Parse fields from JSON
-        item.id = extractJsonValue(json, "id");
-        item.personName = extractJsonValue(json, "personName");
-        item.contactInfo = extractJsonValue(json, "contactInfo");
-        item.category = extractJsonValue(json, "category");
-        item.eventTime = extractJsonValue(json, "eventTime");
-        item.location = extractJsonValue(json, "location");
-        item.reportTime = extractJsonValue(json, "reportTime");
-        item.additionalInfo = extractJsonValue(json, "additionalInfo");
-        item.status = extractJsonValue(json, "status");
-
-        // Parse details map
-        std::string detailsJson = extractJsonObject(json, "details");
-        if (!detailsJson.empty() && detailsJson != "{}") {
-            detailsJson = detailsJson.substr(1, detailsJson.length() - 2); // Remove brackets
-
-            // Split by fields
-            std::vector<std::string> fields;
-            int quoteDepth = 0;
-            std::string currentField;
-
-            for (size_t i = 0; i < detailsJson.length(); i++) {
-                char c = detailsJson[i];
+        ItemCategory category = ItemCategory::OTHER;
+        std::vector<Term> terms; // Sorted by attribute
+        std::array<int8_t, MAX_CATEGORY_ATTRIBUTES> schemaTerms; // Term per schema attribute, or -1
+        bool extraTerms = false; // Has terms outside the category schema
+        int64_t eventMinute = NO_EVENT_TIME;
+        uint32_t locationSymbol = SymbolTable::NO_SYMBOL;
+        uint16_t locationId = NO_LOCATION;
+        std::string location;
+        TrigramSignature locationSignature;
+        std::vector<std::string> textTerms; // Distinct free-text words
+    };
 
-                if (c == '"') {
-                    quoteDepth = (quoteDepth + 1) % 2;
-                    currentField += c;
-                } else if (c == ',' && quoteDepth == 0) {
-                    fields.push_back(currentField);
-                    currentField = "";
-                } else {
-                    currentField += c;
-                }
-            }
+    // Inverted attribute index: per category, maps an (attribute id,
+    // trigram) key to the slots (vector positions) of the items whose value
+    // for that attribute contains the trigram
+    struct AttributeIndex {
+        std::map<ItemCategory, std::unordered_map<uint32_t, std::vector<uint32_t>>> postings;
 
-            if (!currentField.empty()) {
-                fields.push_back(currentField);
-            }
+        // Per category, the slots of the items at each predefined location
+        std::map<ItemCategory, std::unordered_map<uint16_t, std::vector<uint32_t>>> locationPostings;
 
-            // Parse each key-value pair
-            for (const auto& field : fields) {
-                size_t colonPos = field.find(':');
-                if (colonPos != std::string::npos) {
-                    std::string key = field.substr(0, colonPos);
-                    std::string value = field.substr(colonPos + 1);
+        void clear() {
+            postings.clear();
+            locationPostings.clear();
+        }
+    };
 
-                    // Clean up key and value
-                    key = key.substr(key.find('"') + 1);
-                    key = key.substr(0, key.rfind('"'));
+    // Predefined locations with a proximity score for every pair, computed
+    // when the locations are loaded, so scoring two items' locations is a
+    // table lookup: 10 for the same location, 7 for the same floor of a
+    // building, 4 for the same building
+    class LocationGraph {
+    public:
+        void build(const std::vector<Location>& locations) {
+            ids.clear();
+            count = std::min<size_t>(locations.size(), NO_LOCATION);
+            for (size_t i = 0; i < count; i++) {
+                ids.emplace(toLower(locations[i].label()), static_cast<uint16_t>(i));
+            }
 
-                    value = value.substr(value.find('"') + 1);
-                    value = value.substr(0, value.rfind('"'));
+            proximity.assign(count * count, 0);
+            for (size_t a = 0; a < count; a++) {
+                for (size_t b = 0; b < count; b++) {
+                    const Location& first = locations[a];
+                    const Location& second = locations[b];
+                    uint8_t score = 0;
+                    if (a == b) {
+                        score = 10;
+                    } else if (!first.building.empty() && toLower(first.building) == toLower(second.building)) {
+                        score = (!first.floor.empty() && first.floor == second.floor) ? 7 : 4;
+                    }
+                    proximity[a * count + b] = score;
+                }
+            }
 
-                    item.details[key] = value;
+            // Each location's neighbors, nearest first
+            neighbors.assign(count, {});
+            for (size_t a = 0; a < count; a++) {
+                for (size_t b = 0; b < count; b++) {
+                    if (proximity[a * count + b] > 0) {
+                        neighbors[a].push_back(static_cast<uint16_t>(b));
+                    }
                 }
+                std::stable_sort(neighbors[a].begin(), neighbors[a].end(), [&](uint16_t x, uint16_t y) {
+                    return proximity[a * count + x] > proximity[a * count + y];
+                });
             }
         }
 
-        return item;
-    }
-
-    // Extract value for a specific key from JSON
-    std::string extractJsonValue(const std::string& json, const std::string& key) {
-        std::string keySearch = "\"" + key + "\":\"";
-        size_t pos = json.find(keySearch);
-
-        if (pos != std::string::npos) {
-            pos += keySearch.length();
-            size_t endPos = json.find("\"", pos);
+        // Id of the location with this lowercase label, or NO_LOCATION
+        uint16_t find(std::string_view label) const {
+            auto it = ids.find(std::string(label));
+            return it != ids.end() ? it->second : NO_LOCATION;
+        }
 
-            if (endPos != std::string::npos) {
-                return json.substr(pos, endPos - pos);
-            }
+        int score(uint16_t a, uint16_t b) const {
+            return proximity[a * count + b];
         }
 
-        return "";
-    }
+        // Locations with a nonzero proximity to id (itself first)
+        const std::vector<uint16_t>& near(uint16_t id) const {
+            return neighbors[id];
+        }
 
-    // Extract a JSON object for a specific key
-    std::string extractJsonObject(const std::string& json, const std::string& key) {
-        std::string keySearch = "\"" + key + "\":";
-        size_t pos = json.find(keySearch);
+    private:
+        std::unordered_map<std::string, uint16_t> ids;
+        std::vector<uint8_t> proximity;  // count x count, row-major
+        std::vector<std::vector<uint16_t>> neighbors;
+        size_t count = 0;
+    };
 
-        if (pos != std::string::npos) {
-            pos += keySearch.length();
-            size_t startPos = json.find("{", pos);
+    // Left-Right concurrency control (Ramalhete & Correia): two copies of
+    // the data. Readers are wait-free and always use the published copy;
+    // the single writer applies each mutation to the hidden copy, publishes
+    // it, waits for readers still on the old copy to leave, then applies
+    // the same mutation there. Mutations must therefore be deterministic.
+    template <typename T>
+    class LeftRight {
+    public:
+        // Run f against the published copy. Do not keep references into
+        // the copy after f returns.
+        template <typename F>
+        auto read(F&& f) const -> decltype(f(std::declval<const T&>())) {
+            const ReaderIndicator& indicator = indicators[versionIndex.load()];
+            size_t stripe = indicator.arrive();
+            struct Departure {
+                const ReaderIndicator& indicator;
+                size_t stripe;
+                ~Departure() { indicator.depart(stripe); }
+            } departure{indicator, stripe};
+
+            return f(instances[readIndex.load()]);
+        }
 
-            if (startPos != std::string::npos) {
-                int braceDepth = 1;
-                size_t endPos = startPos + 1;
+        // Apply f to both copies (serialized with other writers)
+        template <typename F>
+        void write(F&& f) {
+            std::lock_guard<std::mutex> lock(writerMutex);
 
-                while (braceDepth > 0 && endPos < json.length()) {
-                    if (json[endPos] == '{') {
-                        braceDepth++;
-                    } else if (json[endPos] == '}') {
-                        braceDepth--;
-                    }
+            const int current = readIndex.load();
+            f(instances[1 - current]);
+            readIndex.store(1 - current);
 
-                    endPos++;
-                }
+            // Toggle the indicator new readers register on, then wait for
+            // both to drain so nobody can still be reading `current`
+            const int version = versionIndex.load();
+            indicators[1 - version].waitUntilEmpty();
+            versionIndex.store(1 - version);
+            indicators[version].waitUntilEmpty();
 
-                if (braceDepth == 0) {
-                    return json.substr(startPos, endPos - startPos);
-                }
-            }
+            f(instances[current]);
         }
 
-        return "{}";
-    }
-
-    // Convert item to JSON string
-    std::string itemToJson(const Item& item) {
-        std::stringstream json;
-
-        json << "{";
-        json << "\"id\":\"" << item.id << "\",";
-        json << "\"personName\":\"" << escapeJsonString(item.personName) << "\",";
-        json << "\"contactInfo\":\"" << escapeJsonString(item.contactInfo) << "\",";
-        json << "\"category\":\"" << escapeJsonString(item.category) << "\",";
-        json << "\"eventTime\":\"" << escapeJsonString(item.eventTime) << "\",";
-        json << "\"location\":\"" << escapeJsonString(item.location) << "\",";
-        json << "\"reportTime\":\"" << escapeJsonString(item.reportTime) << "\",";
-
-        // Convert details map to JSON
-        json << "\"details\":{";
-        bool first = true;
-        for (const auto& detail : item.details) {
-            if (!first) {
-                json << ",";
-            }
-            json << "\"" << escapeJsonString(detail.first) << "\":\""
-                 << escapeJsonString(detail.second) << "\"";
-            first = false;
+        // Replace both copies (startup, while no readers exist)
+        void reset(const T& value) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            instances[0] = value;
+            instances[1] = value;
         }
-        json << "},";
-
-        json << "\"additionalInfo\":\"" << escapeJsonString(item.additionalInfo) << "\",";
-        json << "\"status\":\"" << escapeJsonString(item.status) << "\"";
-        json << "}";
 
-        return json.str();
-    }
+    private:
+        // Reader counts striped over cache lines to keep readers on
+        // different cores from contending
+        class ReaderIndicator {
+        public:
+            size_t arrive() const {
+                size_t stripe = threadStripe();
+                counters[stripe].value.fetch_add(1);
+                return stripe;
+            }
 
-    // Escape special characters in JSON string
-    std::string escapeJsonString(const std::string& input) {
-        std::string output;
+            void depart(size_t stripe) const {
+                counters[stripe].value.fetch_sub(1);
+            }
 
-        for (char c : input) {
-            switch (c) {
-                case '\"': output += "\\\""; break;
-                case '\\': output += "\\\\"; break;
-                case '\b': output += "\\b"; break;
-                case '\f': output += "\\f"; break;
-                case '\n': output += "\\n"; break;
-                case '\r': output += "\\r"; break;
-                case '\t': output += "\\t"; break;
-                default:
-                    if (static_cast<unsigned char>(c) < 32) {
-                        // Control characters
-                        char buf[8];
-                        sprintf(buf, "\\u%04x", c);
-                        output += buf;
-                    } else {
-                        output += c;
+            void waitUntilEmpty() const {
+                for (const auto& counter : counters) {
+                    while (counter.value.load() != 0) {
+                        std::this_thread::yield();
                     }
+                }
             }
-        }
 
-        return output;
-    }
-
-    // Save items to files
-    void saveItems() {
-        saveItemsToFile(LOST_ITEMS_FILE, lostItems);
-        saveItemsToFile(FOUND_ITEMS_FILE, foundItems);
-    }
+        private:
+            static constexpr size_t STRIPES = 16;
 
-    // Save items to a specific file
-    void saveItemsToFile(const std::string& filename, const std::vector<Item>& items) {
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file for writing: " << filename << std::endl;
-            return;
-        }
+            struct alignas(64) Counter {
+                mutable std::atomic<int64_t> value{0};
+            };
 
-        file << "[";
+            Counter counters[STRIPES];
 
-        for (size_t i = 0; i < items.size(); i++) {
-            if (i > 0) {
-                file << ",";
+            static size_t threadStripe() {
+                static thread_local size_t stripe =
+                    std::hash<std::thread::id>()(std::this_thread::get_id()) % STRIPES;
+                return stripe;
             }
-            file << itemToJson(items[i]);
-        }
+        };
 
-        file << "]";
-        file.close();
-    }
+        T instances[2];
+        std::atomic<int> readIndex{0};
+        std::atomic<int> versionIndex{0};
+        ReaderIndicator indicators[2];
+        std::mutex writerMutex;
+    };
 
-    // Save a lost item
-    void saveLostItem(
-        const std::string& reporterName,
-        const std::string& contactInfo,
-        ItemCategory category,
-        const std::string& lostTime,
-        const std::string& location,
-        const std::map<std::string, std::string>& itemDetails,
-        const std::string& additionalDetails
-    ) {
-        Item item;
-        item.id = generateId();
-        item.personName = reporterName;
-        item.contactInfo = contactInfo;
-        item.category = categoryNames[category];
-        item.eventTime = lostTime;
-        item.location = location;
-        item.details = itemDetails;
-        item.additionalInfo = additionalDetails;
-        item.reportTime = getCurrentTimestamp();
-        item.status = "OPEN";
-
-        lostItems.push_back(item);
-        saveItems();
-    }
-
-    // Save a found item
-    void saveFoundItem(
-        const std::string& finderName,
-        const std::string& contactInfo,
-        ItemCategory category,
-        const std::string& foundTime,
-        const std::string& location,
-        const std::map<std::string, std::string>& itemDetails,
-        const std::string& additionalDetails
-    ) {
-        Item item;
-        item.id = generateId();
-        item.personName = finderName;
-        item.contactInfo = contactInfo;
-        item.category = categoryNames[category];
-        item.eventTime = foundTime;
-        item.location = location;
-        item.details = itemDetails;
-        item.additionalInfo = additionalDetails;
-        item.reportTime = getCurrentTimestamp();
-        item.status = "OPEN";
+    // A ranked search hit: slot in the searched list and its score
+    struct SearchResult {
+        uint32_t slot;
+        int score;
+    };
 
-        foundItems.push_back(item);
-        saveItems();
-    }
+    // Default time window for matching: items whose event times are
+    // further apart than this are not compared
+    static constexpr int64_t MATCH_WINDOW_DAYS = 30;
+
+    // Windows holding at most 1/this of a category are scanned directly
+    static constexpr size_t WINDOW_SCAN_FRACTION = 8;
+
+    // Paging, cutoff and time window for findMatches
+    struct SearchOptions {
+        size_t limit = 10;    // Results per page
+        size_t offset = 0;    // Results to skip
+        int minScore = 1;     // Items scoring below this are dropped
+        int64_t windowMinutes = MATCH_WINDOW_DAYS * 24 * 60;  // 0 for no window
+        bool openOnly = true; // Skip items that are not OPEN
+        bool resolvedOnly = false;  // Skip OPEN items
+    };
+
+    // Event times per category, sorted, for time-window searches. Items
+    // without a parsable time are kept too (NO_EVENT_TIME sorts first), so
+    // windowed searches still consider them.
+    struct TimeIndex {
+        std::map<ItemCategory, std::vector<std::pair<int64_t, uint32_t>>> entries;
 
-    // Calculate match score between two items (simple matching algorithm)
-    int calculateMatchScore(const Item& item1, const Item& item2) {
-        if (item1.category != item2.category) {
-            return 0;  // Different categories, no match
+        void clear() {
+            entries.clear();
         }
+    };
 
-        int score = 0;
+    // Full-text index over each item's free text (additionalInfo and
+    // distinguishing_features) for BM25 ranking, with postings per category.
+    // Slots only grow, so each posting list is kept as (slot delta, term
+    // frequency) varint pairs.
+    struct TextIndex {
+        struct Postings {
+            std::vector<uint8_t> bytes;
+            uint32_t documentCount = 0;
+            uint32_t lastSlot = 0;
+        };
 
-        // Compare details
-        for (const auto& detail1 : item1.details) {
-            auto it = item2.details.find(detail1.first);
-            if (it != item2.details.end()) {
-                // Found matching attribute, check value
-                std::string value1 = detail1.second;
-                std::string value2 = it->second;
+        std::map<ItemCategory, std::unordered_map<std::string, Postings>> terms;
+        std::vector<uint16_t> documentLengths;  // Words per slot
+        uint64_t totalLength = 0;
 
-                // Convert to lowercase for comparison
-                std::transform(value1.begin(), value1.end(), value1.begin(), ::tolower);
-                std::transform(value2.begin(), value2.end(), value2.begin(), ::tolower);
+        void clear() {
+            terms.clear();
+            documentLengths.clear();
+            totalLength = 0;
+        }
+    };
 
-                if (value1 == value2) {
-                    score += 10;  // Exact match
-                } else if (value1.find(value2) != std::string::npos ||
-                           value2.find(value1) != std::string::npos) {
-                    score += 5;   // Partial match
-                }
+    // Columnar copy of the fields a search scores, per category and per
+    // list: row r is the category's r-th item by slot, so rows and slots
+    // sort alike. Detail values are kept as symbols (an exact match is an
+    // equal symbol), one column per attribute the category's items use;
+    // a missing value is symbol 0, the empty string.
+    struct ScoringColumns {
+        struct Category {
+            std::vector<uint32_t> slots;
+            std::vector<uint8_t> open;            // 1 if the item is OPEN
+            std::vector<int64_t> eventMinutes;
+            std::vector<uint16_t> locationIds;
+            std::vector<uint32_t> locationSymbols;
+            std::vector<uint8_t> attributes;      // Attribute id per column
+            std::vector<std::vector<uint32_t>> values;  // Per column, per row
+
+            const uint32_t* column(uint8_t attribute) const {
+                auto it = std::find(attributes.begin(), attributes.end(), attribute);
+                return it == attributes.end() ? nullptr : values[it - attributes.begin()].data();
             }
-        }
+        };
 
-        // Check location for similarity
-        std::string loc1 = item1.location;
-        std::string loc2 = item2.location;
-        std::transform(loc1.begin(), loc1.end(), loc1.begin(), ::tolower);
-        std::transform(loc2.begin(), loc2.end(), loc2.begin(), ::tolower);
+        std::map<ItemCategory, Category> categories;
+        std::vector<uint32_t> rows;  // Row of each slot in its category
 
-        if (loc1 == loc2) {
-            score += 10;  // Same location
-        } else if (loc1.find(loc2) != std::string::npos ||
-                   loc2.find(loc1) != std::string::npos) {
-            score += 5;   // Similar location
+        void clear() {
+            categories.clear();
+            rows.clear();
         }
 
-        return score;
-    }
-
-    // Search for matching items
-    void searchForMatches(bool isLostItem, const std::string& category, const std::map<std::string, std::string>& searchDetails) {
-        const std::vector<Item>& searchIn = isLostItem ? foundItems : lostItems;
-
-        // Create temporary item for comparison
-        Item searchItem;
-        searchItem.category = category;
-        searchItem.details = searchDetails;
-
-        // Find potential matches
-        std::vector<std::pair<Item, int>> matches;  // Item and match score
-
-        for (const auto& item : searchIn) {
-            if (item.category == category && item.status == "OPEN") {
-                int score = calculateMatchScore(searchItem, item);
-                if (score > 0) {
-                    matches.push_back({item, score});
+        // Append an item (slots must be added in increasing order)
+        void add(const Item& item, uint32_t slot) {
+            Category& category = categories[item.category];
+            const size_t row = category.slots.size();
+            category.slots.push_back(slot);
+            category.open.push_back(item.status == ItemStatus::OPEN);
+            category.eventMinutes.push_back(item.eventMinute);
+            category.locationIds.push_back(item.locationId);
+            category.locationSymbols.push_back(item.locationSymbol);
+            for (auto& values : category.values) {
+                values.push_back(0);
+            }
+            for (const auto& detail : item.normalizedDetails) {
+                auto it = std::find(category.attributes.begin(), category.attributes.end(), detail.attribute);
+                if (it == category.attributes.end()) {
+                    category.attributes.push_back(detail.attribute);
+                    category.values.emplace_back(row + 1, 0);
+                    it = category.attributes.end() - 1;
                 }
+                category.values[it - category.attributes.begin()][row] = detail.value;
             }
+            rows.resize(slot + 1);
+            rows[slot] = static_cast<uint32_t>(row);
         }
 
-        // Sort by score (highest first)
-        std::sort(matches.begin(), matches.end(),
-                 [](const auto& a, const auto& b) { return a.second > b.second; });
-
-        // Display matches
-        std::cout << "\nPotential matches found: " << matches.size() << std::endl;
+        void setOpen(const Item& item, uint32_t slot) {
+            categories[item.category].open[rows[slot]] = item.status == ItemStatus::OPEN;
+        }
+    };
 
-        for (size_t i = 0; i < matches.size(); i++) {
-            const auto& match = matches[i];
-            std::cout << "\nMatch #" << (i + 1) << " (Score: " << match.second << "):" << std::endl;
-            std::cout << "Category: " << match.first.category << std::endl;
-            std::cout << "Location: " << match.first.location << std::endl;
-            std::cout << (isLostItem ? "Found" : "Lost") << " Time: " << match.first.eventTime << std::endl;
+    // A query term as the scoring kernel sees it: a column and the symbol
+    // to compare it with
+    struct ColumnTerm {
+        const uint32_t* values;
+        uint32_t symbol;
+    };
 
-            std::cout << "Details:" << std::endl;
-            for (const auto& detail : match.first.details) {
-                std::string displayName = detail.first;
-                std::replace(displayName.begin(), displayName.end(), '_', ' ');
-                if (!displayName.empty()) {
-                    displayName[0] = std::toupper(displayName[0]);
+    // Exact-match part of the detail score for rows [begin, end): exact[r]
+    // gets 10 per term whose symbol equals the row's value, and bit t of
+    // fuzzy[r] is set when term t's value is neither equal nor blank, so
+    // only those are left for fuzzy scoring
+    static void exactScoresScalar(const ColumnTerm* terms, size_t termCount, size_t begin, size_t end,
+                                  uint32_t* exact, uint32_t* fuzzy) {
+        for (size_t r = begin; r < end; r++) {
+            uint32_t score = 0;
+            uint32_t flags = 0;
+            for (size_t t = 0; t < termCount; t++) {
+                const uint32_t value = terms[t].values[r];
+                if (value == terms[t].symbol) {
+                    score += 10;
+                } else if (value != 0) {
+                    flags |= 1u << t;
                 }
-                std::cout << "  " << displayName << ": " << detail.second << std::endl;
             }
+            exact[r] = score;
+            fuzzy[r] = flags;
+        }
+    }
 
-            std::cout << "Additional Info: " << match.first.additionalInfo << std::endl;
-
-            // Ask if user wants to contact the person
-            if (i < matches.size() - 1) {
-                std::cout << "\nPress Enter to see next match or 'C' to contact this person: ";
-            } else {
-                std::cout << "\nPress 'C' to contact this person or any other key to return: ";
+#ifdef LFB_HAVE_AVX2
+    // The same, eight rows at a time
+    __attribute__((target("avx2")))
+    static void exactScoresAvx2(const ColumnTerm* terms, size_t termCount, size_t rows,
+                                uint32_t* exact, uint32_t* fuzzy) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i ten = _mm256_set1_epi32(10);
+        size_t r = 0;
+        for (; r + 8 <= rows; r += 8) {
+            __m256i score = zero;
+            __m256i flags = zero;
+            for (size_t t = 0; t < termCount; t++) {
+                const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(terms[t].values + r));
+                const __m256i equal = _mm256_cmpeq_epi32(values, _mm256_set1_epi32(static_cast<int>(terms[t].symbol)));
+                const __m256i settled = _mm256_or_si256(equal, _mm256_cmpeq_epi32(values, zero));
+                score = _mm256_add_epi32(score, _mm256_and_si256(equal, ten));
+                flags = _mm256_or_si256(flags, _mm256_andnot_si256(settled, _mm256_set1_epi32(1 << t)));
             }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(exact + r), score);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(fuzzy + r), flags);
+        }
+        exactScoresScalar(terms, termCount, r, rows, exact, fuzzy);
+    }
+#endif
+
+    // Run the best exact-score kernel this CPU supports over rows [0, rows)
+    static void exactScores(const ColumnTerm* terms, size_t termCount, size_t rows, uint32_t* exact, uint32_t* fuzzy) {
+#ifdef LFB_HAVE_AVX2
+        static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+        if (hasAvx2) {
+            exactScoresAvx2(terms, termCount, rows, exact, fuzzy);
+            return;
+        }
+#endif
+        exactScoresScalar(terms, termCount, 0, rows, exact, fuzzy);
+    }
 
-            std::string response;
-            std::getline(std::cin, response);
+    // Lowest score at which a new found item notifies a standing query
+    static constexpr int STANDING_MATCH_MIN_SCORE = 10;
 
-            if (response == "C" || response == "c") {
-                std::cout << "\nContact Information:" << std::endl;
-                std::cout << "Name: " << match.first.personName << std::endl;
-                std::cout << "Contact: " << match.first.contactInfo << std::endl;
+    // Open lost reports as standing queries, keyed on (category, attribute,
+    // value symbol), so a new found item is only scored against the lost
+    // reports sharing one of its exact detail values. A report is listed
+    // under every non-blank value it has, so a found item sharing any one
+    // of them reaches it; a report with no detail values has no standing
+    // query.
+    struct Percolator {
+        std::unordered_map<uint64_t, std::vector<uint32_t>> queries;  // Sorted lost slots
 
-                std::cout << "\nPress Enter to continue...";
-                std::getline(std::cin, response);
-                break;
-            }
+        static uint64_t key(ItemCategory category, const NormalizedDetail& detail) {
+            return static_cast<uint64_t>(category) << 40 | static_cast<uint64_t>(detail.attribute) << 32 | detail.value;
         }
 
-        if (matches.empty()) {
-            std::cout << "No potential matches found." << std::endl;
+        void clear() {
+            queries.clear();
         }
-    }
+    };
 
-public:
-    // Constructor
-    LostFoundBot() {
-        initCategoryAttributes();
-        initDataStorage();
-    }
+    // Item counts per (list, category, location, status) series, by event
+    // hour, kept up to date on every add and status change so counting
+    // reports never touch the items. Undated items count under hour
+    // NO_EVENT_TIME, which sorts before every real hour.
+    struct Rollups {
+        std::unordered_map<uint64_t, std::map<int64_t, uint32_t>> series;
 
-    // Start the bot and display the main menu
-    void start() {
-        bool running = true;
+        static uint64_t key(bool isLost, ItemCategory category, uint16_t locationId, ItemStatus status) {
+            return static_cast<uint64_t>(isLost) << 40 | static_cast<uint64_t>(category) << 32 |
+                   static_cast<uint64_t>(locationId) << 8 | static_cast<uint64_t>(status);
+        }
 
-        while (running) {
-            std::cout << "\n===== LOST & FOUND BOT =====\n"
-                      << "1. Report a lost item\n"
-                      << "2. Report a found item\n"
-                      << "3. Search for items\n"
-                      << "4. Exit\n"
-                      << "Enter your choice: ";
+        static bool isLost(uint64_t key) { return (key >> 40) & 1; }
+        static ItemCategory category(uint64_t key) { return static_cast<ItemCategory>((key >> 32) & 0xFF); }
+        static uint16_t locationId(uint64_t key) { return static_cast<uint16_t>(key >> 8); }
+        static ItemStatus status(uint64_t key) { return static_cast<ItemStatus>(key & 0xFF); }
 
-            int choice = getIntInput("", 1, 4);
+        static int64_t hourOf(int64_t eventMinute) {
+            if (eventMinute == NO_EVENT_TIME) {
+                return NO_EVENT_TIME;
+            }
+            return eventMinute >= 0 ? eventMinute / 60 : (eventMinute - 59) / 60;
+        }
 
-            switch (choice) {
-                case 1:
-                    reportLostItem();
-                    break;
-                case 2:
-                    reportFoundItem();
-                    break;
-                case 3:
-                    searchItems();
-                    break;
-                case 4:
-                    running = false;
-                    std::cout << "Thank you for using Lost & Found Bot. Goodbye!" << std::endl;
-                    break;
+        // Count an item in (delta 1) or out of (delta -1) its series
+        void add(bool isLost, const Item& item, int delta) {
+            auto& hours = series[key(isLost, item.category, item.locationId, item.status)];
+            auto it = hours.emplace(hourOf(item.eventMinute), 0).first;
+            it->second += delta;
+            if (it->second == 0) {
+                hours.erase(it);
             }
         }
-    }
 
-    // Report a lost item
-    void reportLostItem() {
-        std::cout << "\n===== REPORT A LOST ITEM =====" << std::endl;
+        void clear() {
+            series.clear();
+        }
+    };
 
-        // Get user information
-        std::string reporterName = getInput("Enter your name: ");
-        std::string contactInfo = getInput("Enter your contact (phone/email): ");
+    // In-memory item store: both item lists with their normalized forms,
+    // the symbol table and the secondary indexes. Shared between threads
+    // through LeftRight, so everything that changes lives in here.
+    struct ItemStore {
+        SymbolTable symbols;
 
-        // Get item category
-        ItemCategory category = getItemCategory();
+        // Attribute names to small ids (all categories share one numbering)
+        std::map<std::string, uint8_t, std::less<>> attributeIds;
+        std::vector<std::string> attributeNames;
 
-        // Get when the item was lost
-        std::string lostTime = getDateTime("When did you lose the item?");
+        // Per category, each attribute id's position in the schema (-1 if
+        // the category's schema does not have it)
+        std::array<std::array<int8_t, UINT8_MAX + 1>, CATEGORY_COUNT> schemaSlots;
 
-        // Get location where item was lost
-        std::string location = getLocation();
+        std::vector<Item> lostItems;
+        std::vector<Item> foundItems;
 
-        // Get item details based on category
-        std::map<std::string, std::string> itemDetails = getItemDetails(category);
+        AttributeIndex lostIndex;
+        AttributeIndex foundIndex;
 
-        // Get additional description
-        std::string additionalDetails = getInput("Please provide any additional details about the item: ");
+        TextIndex lostText;
+        TextIndex foundText;
 
-        // Save to storage
-        saveLostItem(reporterName, contactInfo, category, lostTime, location,
-                     itemDetails, additionalDetails);
+        TimeIndex lostTimes;
+        TimeIndex foundTimes;
 
-        std::cout << "Lost item report submitted successfully!" << std::endl;
+        Percolator standingQueries;
 
-        // Check for potential matches
-        searchForMatches(true, categoryNames[category], itemDetails);
-    }
+        ScoringColumns lostColumns;
+        ScoringColumns foundColumns;
 
-    // Report a found item
-    void reportFoundItem() {
-        std::cout << "\n===== REPORT A FOUND ITEM =====" << std::endl;
+        Rollups rollups;
 
-        // Get finder information
-        std::string finderName = getInput("Enter your name: ");
-        std::string contactInfo = getInput("Enter your contact (phone/email): ");
+        LocationGraph locations;
 
-        // Get item category
-        ItemCategory category = getItemCategory();
+        // Where each item lives, by id
+        struct ItemRef {
+            bool isLost;
+            uint32_t slot;
+        };
+        std::unordered_map<std::string_view, ItemRef> idSlots;  // Keys view the items' ids
 
-        // Get when the item was found
-        std::string foundTime = getDateTime("When did you find the item?");
+        // Items with ULID ids, sorted by id and so by creation time
+        std::vector<std::pair<std::string_view, ItemRef>> idOrder;
 
-        // Get location where item was found
-        std::string location = getLocation();
+        // Only OPEN items are in the attribute, location and time indexes
+        // (the archive sets this to false to index everything)
+        bool indexOpenOnly = true;
 
-        // Get item details based on category
-        std::map<std::string, std::string> itemDetails = getItemDetails(category);
+        // Sorted slots of the items the indexes leave out, kept in step by
+        // setStatus, so resolved items are searched without a full scan
+        std::vector<uint32_t> lostUnindexed;
+        std::vector<uint32_t> foundUnindexed;
 
-        // Get additional description
-        std::string additionalDetails = getInput("Please provide any additional details about the item: ");
+        const std::vector<Item>& items(bool isLost) const {
+            return isLost ? lostItems : foundItems;
+        }
 
-        // Save to storage
-        saveFoundItem(finderName, contactInfo, category, foundTime, location,
-                      itemDetails, additionalDetails);
+        // Schema attributes are numbered first, in schema order, so every
+        // store gives them the same ids
+        ItemStore() {
+            for (auto& slots : schemaSlots) {
+                slots.fill(-1);
+            }
+            for (size_t category = 0; category < CATEGORY_COUNT; category++) {
+                const CategorySchema& schema = CATEGORY_SCHEMAS[category];
+                for (size_t slot = 0; slot < schema.attributeCount; slot++) {
+                    schemaSlots[category][attributeId(schema.attributes[slot])] = static_cast<int8_t>(slot);
+                }
+            }
+        }
 
-        std::cout << "Found item report submitted successfully!" << std::endl;
+        // Add a new item (normalized and indexed)
+        void addItem(bool isLost, const Item& item) {
+            std::vector<Item>& list = isLost ? lostItems : foundItems;
+            const uint32_t slot = static_cast<uint32_t>(list.size());
+            list.push_back(item);
+            normalizeItem(list.back());
+            idSlots[item.id] = {isLost, slot};
+            if (ulidMillis(item.id) >= 0) {
+                // New ids are the newest, so this appends
+                std::pair<std::string_view, ItemRef> entry(list.back().id, ItemRef{isLost, slot});
+                idOrder.insert(std::upper_bound(idOrder.begin(), idOrder.end(), entry, compareIdOrder), entry);
+            }
+            indexText(isLost ? lostText : foundText, list.back(), slot);
+            (isLost ? lostColumns : foundColumns).add(list.back(), slot);
+            rollups.add(isLost, list.back(), 1);
+            if (isIndexed(list.back())) {
+                updateIndexes(isLost, list.back(), slot, true);
+            } else {
+                (isLost ? lostUnindexed : foundUnindexed).push_back(slot);
+            }
+        }
 
-        // Check for potential matches
-        searchForMatches(false, categoryNames[category], itemDetails);
-    }
+        static bool compareIdOrder(const std::pair<std::string_view, ItemRef>& a,
+                                   const std::pair<std::string_view, ItemRef>& b) {
+            return a.first < b.first;
+        }
 
-    // Search for items
-    void searchItems() {
-        std::cout << "\n===== SEARCH FOR ITEMS =====" << std::endl;
-        std::cout << "1. Search for lost items\n"
-                  << "2. Search for found items\n"
-                  << "3. Back to main menu" << std::endl;
+        // Point lookup by id (nullptr if absent)
+        const Item* findItem(std::string_view id, bool* isLost = nullptr) const {
+            auto it = idSlots.find(id);
+            if (it == idSlots.end()) {
+                return nullptr;
+            }
+            if (isLost) {
+                *isLost = it->second.isLost;
+            }
+            return &items(it->second.isLost)[it->second.slot];
+        }
 
-        int choice = getIntInput("Enter your choice: ", 1, 3);
+        // Items created at or after sinceMillis (Unix ms), oldest first, by
+        // a binary search on the ULID order. Items with older non-ULID ids
+        // are not included.
+        std::vector<ItemRef> itemsSince(int64_t sinceMillis, size_t limit) const {
+            // The smallest ULID of that millisecond: its time, then zeros
+            std::string first(ULID_LENGTH, '0');
+            for (size_t i = 10; i-- > 0;) {
+                first[i] = ULID_ALPHABET[sinceMillis & 31];
+                sinceMillis >>= 5;
+            }
 
-        if (choice == 3) {
-            return;
+            auto it = std::lower_bound(idOrder.begin(), idOrder.end(), std::make_pair(std::string_view(first), ItemRef{}),
+                                       compareIdOrder);
+            std::vector<ItemRef> result;
+            for (; it != idOrder.end() && result.size() < limit; ++it) {
+                result.push_back(it->second);
+            }
+            return result;
         }
 
-        bool searchingLost = (choice == 2); // If looking for found items, we search lost items
+        bool isIndexed(const Item& item) const {
+            return !indexOpenOnly || item.status == ItemStatus::OPEN;
+        }
 
-        // Get search criteria
-        ItemCategory category = getItemCategory();
+        // Change an item's status, keeping the indexes in step: an item
+        // leaving OPEN is taken out of the attribute, location and time
+        // indexes, and put back if reopened. Text postings are
+        // delta-encoded, so they keep the slot and findMatches skips it by
+        // status. Returns false if no item has the id.
+        bool setStatus(const std::string& id, ItemStatus status) {
+            auto it = idSlots.find(id);
+            if (it == idSlots.end()) {
+                return false;
+            }
 
-        // Get item details based on category for searching
-        std::map<std::string, std::string> searchDetails = getItemDetails(category);
+            const ItemRef ref = it->second;
+            Item& item = (ref.isLost ? lostItems : foundItems)[ref.slot];
+            const bool wasIndexed = isIndexed(item);
+            rollups.add(ref.isLost, item, -1);
+            item.status = status;
+            rollups.add(ref.isLost, item, 1);
+            (ref.isLost ? lostColumns : foundColumns).setOpen(item, ref.slot);
+            if (wasIndexed != isIndexed(item)) {
+                updateIndexes(ref.isLost, item, ref.slot, isIndexed(item));
+                setMember(ref.isLost ? lostUnindexed : foundUnindexed, ref.slot, !isIndexed(item));
+            }
+            return true;
+        }
 
-        // Search for potential matches
-        searchForMatches(searchingLost, categoryNames[category], searchDetails);
-    }
-};
+        // Add (or remove) one item's entries in the attribute, location and
+        // time indexes. Every list involved is sorted, so each entry is
+        // found by binary search.
+        void updateIndexes(bool isLost, const Item& item, uint32_t slot, bool add) {
+            AttributeIndex& index = isLost ? lostIndex : foundIndex;
+
+            auto& categoryPostings = index.postings[item.category];
+            for (const auto& detail : item.normalizedDetails) {
+                for (uint32_t trigram : valueTrigrams(symbols.text(detail.value))) {
+                    setMember(categoryPostings[indexKey(detail.attribute, trigram)], slot, add);
+                }
+            }
+
+            if (item.locationId != NO_LOCATION) {
+                setMember(index.locationPostings[item.category][item.locationId], slot, add);
+            }
+
+            // Reports mostly arrive in time order, so this inserts near the end
+            auto& entries = (isLost ? lostTimes : foundTimes).entries[item.category];
+            setMember(entries, std::make_pair(item.eventMinute, slot), add);
+
+            if (isLost) {
+                if (add && item.status == ItemStatus::OPEN) {
+                    registerStandingQuery(item, slot);
+                } else {
+                    unregisterStandingQuery(item, slot);
+                }
+            }
+        }
+
+        // Register an open lost report under each of its non-blank detail values
+        void registerStandingQuery(const Item& item, uint32_t slot) {
+            for (const auto& detail : item.normalizedDetails) {
+                if (detail.value == 0) {
+                    continue;  // Empty value
+                }
+                setMember(standingQueries.queries[Percolator::key(item.category, detail)], slot, true);
+            }
+        }
+
+        // Take a lost report out of every list it is registered in
+        void unregisterStandingQuery(const Item& item, uint32_t slot) {
+            for (const auto& detail : item.normalizedDetails) {
+                auto it = standingQueries.queries.find(Percolator::key(item.category, detail));
+                if (it != standingQueries.queries.end()) {
+                    setMember(it->second, slot, false);
+                    if (it->second.empty()) {
+                        standingQueries.queries.erase(it);
+                    }
+                }
+            }
+        }
+
+        // Open lost reports a stored found item satisfies: the standing
+        // queries registered under its detail values, within the match
+        // window and scoring at least minScore, best first
+        std::vector<std::pair<uint32_t, int>> percolate(const Item& found, int minScore) const {
+            std::vector<uint32_t> slots;
+            for (const auto& detail : found.normalizedDetails) {
+                auto it = standingQueries.queries.find(Percolator::key(found.category, detail));
+                if (it != standingQueries.queries.end()) {
+                    slots.insert(slots.end(), it->second.begin(), it->second.end());
+                }
+            }
+            std::sort(slots.begin(), slots.end());
+            slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+
+            const int64_t windowMinutes = MATCH_WINDOW_DAYS * 24 * 60;
+            std::vector<std::pair<uint32_t, int>> matches;
+            for (uint32_t slot : slots) {
+                const Item& lost = lostItems[slot];
+                if (lost.status != ItemStatus::OPEN) {
+                    continue;
+                }
+                if (lost.eventMinute != NO_EVENT_TIME && found.eventMinute != NO_EVENT_TIME &&
+                    std::abs(lost.eventMinute - found.eventMinute) > windowMinutes) {
+                    continue;
+                }
+                int score = calculateMatchScore(lost, found);
+                if (score >= minScore) {
+                    matches.emplace_back(slot, score);
+                }
+            }
+
+            std::stable_sort(matches.begin(), matches.end(),
+                             [](const std::pair<uint32_t, int>& a, const std::pair<uint32_t, int>& b) {
+                                 return a.second > b.second;
+                             });
+            return matches;
+        }
+
+        // Insert value into (or erase it from) a sorted vector
+        template <typename T>
+        static void setMember(std::vector<T>& sorted, const T& value, bool member) {
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), value);
+            const bool present = (it != sorted.end() && *it == value);
+            if (member && !present) {
+                sorted.insert(it, value);
+            } else if (!member && present) {
+                sorted.erase(it);
+            }
+        }
+
+        // Get the id for an attribute name, assigning one if needed
+        // (returns -1 once all 256 ids are taken)
+        int attributeId(std::string_view name) {
+            auto it = attributeIds.find(name);
+            if (it != attributeIds.end()) {
+                return it->second;
+            }
+            if (attributeNames.size() > UINT8_MAX) {
+                return -1;
+            }
+
+            uint8_t id = static_cast<uint8_t>(attributeNames.size());
+            attributeNames.emplace_back(name);
+            attributeIds.emplace(std::string(name), id);
+            return id;
+        }
+
+        // Fill in the normalized form of an item: interned lowercase location
+        // and detail values, detail keys as attribute ids
+        void normalizeItem(Item& item) {
+            item.eventMinute = parseEventMinute(item.eventTime);
+            item.locationSymbol = symbols.intern(toLower(item.location));
+            item.locationId = locations.find(symbols.text(item.locationSymbol));
+
+            item.normalizedDetails.clear();
+            item.normalizedDetails.reserve(item.details.size());
+            item.schemaValues.fill(0);
+            item.extraDetails = false;
+            const auto& slots = schemaSlots[static_cast<size_t>(item.category)];
+            for (const auto& detail : item.details) {
+                int attribute = attributeId(detail.first);
+                if (attribute >= 0) {
+                    uint32_t value = symbols.intern(toLower(detail.second));
+                    item.normalizedDetails.push_back({static_cast<uint8_t>(attribute), value});
+                    if (slots[attribute] >= 0) {
+                        item.schemaValues[slots[attribute]] = value;
+                    } else {
+                        item.extraDetails = true;
+                    }
+                }
+            }
+
+            std::sort(item.normalizedDetails.begin(), item.normalizedDetails.end(),
+                      [](const NormalizedDetail& a, const NormalizedDetail& b) { return a.attribute < b.attribute; });
+        }
+
+        // Build a normalized query without growing the symbol table
+        MatchQuery buildQuery(ItemCategory category, const std::map<std::string, std::string>& details,
+                              std::string_view location = {}, std::string_view text = {},
+                              std::string_view eventTime = {}) const {
+            MatchQuery query;
+            query.category = category;
+            query.eventMinute = parseEventMinute(eventTime);
+            query.location = toLower(location);
+            query.locationSymbol = symbols.find(query.location);
+            query.locationId = locations.find(query.location);
+            query.locationSignature = trigramSignature(query.location);
+
+            auto features = details.find("distinguishing_features");
+            query.textTerms = textTerms(std::string(text) + " " + (features != details.end() ? features->second : ""));
+
+            for (const auto& detail : details) {
+                auto it = attributeIds.find(detail.first);
+                if (it == attributeIds.end()) {
+                    continue;  // No stored item can have this attribute
+                }
+                std::string text = toLower(detail.second);
+                uint32_t value = symbols.find(text);
+                TrigramSignature signature = trigramSignature(text);
+                query.terms.push_back({it->second, value, std::move(text), signature});
+            }
+
+            std::sort(query.terms.begin(), query.terms.end(),
+                      [](const MatchQuery::Term& a, const MatchQuery::Term& b) { return a.attribute < b.attribute; });
+            mapSchemaTerms(query);
+            return query;
+        }
+
+        // Fill in which term (if any) each schema attribute of the query's
+        // category has
+        void mapSchemaTerms(MatchQuery& query) const {
+            const auto& slots = schemaSlots[static_cast<size_t>(query.category)];
+            query.schemaTerms.fill(-1);
+            query.extraTerms = false;
+            for (size_t i = 0; i < query.terms.size(); i++) {
+                const int slot = slots[query.terms[i].attribute];
+                if (slot >= 0) {
+                    query.schemaTerms[slot] = static_cast<int8_t>(i);
+                } else {
+                    query.extraTerms = true;
+                }
+            }
+        }
+
+        // Build a query that looks for items like the given one
+        MatchQuery queryFromItem(const Item& item) const {
+            MatchQuery query;
+            query.category = item.category;
+            query.eventMinute = item.eventMinute;
+            query.locationSymbol = item.locationSymbol;
+            query.locationId = item.locationId;
+            query.location = symbols.text(item.locationSymbol);
+            query.locationSignature = symbols.signature(item.locationSymbol);
+            for (const auto& detail : item.normalizedDetails) {
+                query.terms.push_back({detail.attribute, detail.value, std::string(symbols.text(detail.value)),
+                                       symbols.signature(detail.value)});
+            }
+            mapSchemaTerms(query);
+            query.textTerms = textTerms(itemText(item));
+            return query;
+        }
+
+        // Calculate match score between a query and an item (simple matching
+        // algorithm over the normalized forms; allocation-free)
+        int calculateMatchScore(const MatchQuery& query, const Item& item) const {
+            Metrics::add(Metrics::SCORE_CALLS);
+            if (query.category != item.category) {
+                return 0;  // Different categories, no match
+            }
+
+            return detailScore(query, item) + locationScore(query, item);
+        }
+
+        // Score of the query's details against an item's. Unless both sides
+        // have details outside the category schema, this is the category's
+        // compile-time scorer over the schema values.
+        int detailScore(const MatchQuery& query, const Item& item) const {
+            if (query.category == item.category && !(query.extraTerms && item.extraDetails)) {
+                return schemaScore(query, item, std::make_index_sequence<CATEGORY_COUNT>{});
+            }
+
+            int score = 0;
+
+            // Compare details; both sides are sorted by attribute id
+            auto detail = item.normalizedDetails.begin();
+            for (const auto& term : query.terms) {
+                while (detail != item.normalizedDetails.end() && detail->attribute < term.attribute) {
+                    ++detail;
+                }
+                if (detail == item.normalizedDetails.end()) {
+                    break;
+                }
+                if (detail->attribute == term.attribute) {
+                    score += valueScore(term.value, term.signature, detail->value, symbols.signature(detail->value));
+                }
+            }
+
+            return score;
+        }
+
+        // Pick the item's category's scorer (the fold compiles to a switch)
+        template <size_t... C>
+        int schemaScore(const MatchQuery& query, const Item& item, std::index_sequence<C...>) const {
+            const size_t category = static_cast<size_t>(item.category);
+            int score = 0;
+            ((category == C && (score = schemaScore<static_cast<ItemCategory>(C)>(query, item), true)) || ...);
+            return score;
+        }
+
+        // Detail score over category C's schema, unrolled per attribute
+        template <ItemCategory C>
+        int schemaScore(const MatchQuery& query, const Item& item) const {
+            return schemaSlotScore(query, item,
+                                   std::make_index_sequence<CATEGORY_SCHEMAS[static_cast<size_t>(C)].attributeCount>{});
+        }
+
+        template <size_t... Slot>
+        int schemaSlotScore(const MatchQuery& query, const Item& item, std::index_sequence<Slot...>) const {
+            return (schemaValueScore(query, item, Slot) + ... + 0);
+        }
+
+        int schemaValueScore(const MatchQuery& query, const Item& item, size_t slot) const {
+            const int term = query.schemaTerms[slot];
+            if (term < 0) {
+                return 0;
+            }
+            const MatchQuery::Term& queryTerm = query.terms[term];
+            const uint32_t value = item.schemaValues[slot];
+            return valueScore(queryTerm.value, queryTerm.signature, value, symbols.signature(value));
+        }
+
+        // Score of the query's location against an item's: by proximity
+        // when both are predefined, otherwise by text similarity
+        int locationScore(const MatchQuery& query, const Item& item) const {
+            return locationScore(query, item.locationId, item.locationSymbol);
+        }
+
+        int locationScore(const MatchQuery& query, uint16_t locationId, uint32_t locationSymbol) const {
+            if (query.locationId != NO_LOCATION && locationId != NO_LOCATION) {
+                return locations.score(query.locationId, locationId);
+            }
+            return valueScore(query.locationSymbol, query.locationSignature,
+                              locationSymbol, symbols.signature(locationSymbol));
+        }
+
+        // Calculate match score between two stored items
+        int calculateMatchScore(const Item& item1, const Item& item2) const {
+            return calculateMatchScore(queryFromItem(item1), item2);
+        }
+
+        // Add an item's attribute trigrams to an index (slots must be added
+        // in increasing order; see updateIndexes otherwise)
+        void indexItem(AttributeIndex& index, const Item& item, size_t slot) {
+            auto& categoryPostings = index.postings[item.category];
+
+            for (const auto& detail : item.normalizedDetails) {
+                for (uint32_t trigram : valueTrigrams(symbols.text(detail.value))) {
+                    categoryPostings[indexKey(detail.attribute, trigram)].push_back(static_cast<uint32_t>(slot));
+                }
+            }
+
+            if (item.locationId != NO_LOCATION) {
+                index.locationPostings[item.category][item.locationId].push_back(static_cast<uint32_t>(slot));
+            }
+        }
+
+        // Slots (sorted) of the items in the query's category at or near
+        // its predefined location, walking the nearest locations first
+        std::vector<uint32_t> findNearby(const AttributeIndex& index, const MatchQuery& query) const {
+            std::vector<uint32_t> candidates;
+
+            auto categoryIt = index.locationPostings.find(query.category);
+            if (query.locationId == NO_LOCATION || categoryIt == index.locationPostings.end()) {
+                return candidates;
+            }
+
+            for (uint16_t id : locations.near(query.locationId)) {
+                auto postingIt = categoryIt->second.find(id);
+                if (postingIt != categoryIt->second.end()) {
+                    candidates.insert(candidates.end(), postingIt->second.begin(), postingIt->second.end());
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end());
+            return candidates;
+        }
+
+        // Add an item's free text to a text index (slots must be added in
+        // increasing order)
+        void indexText(TextIndex& index, const Item& item, size_t slot) {
+            std::vector<std::string> words = tokenizeText(itemText(item));
+            index.documentLengths.resize(slot + 1, 0);
+            index.documentLengths[slot] = static_cast<uint16_t>(std::min<size_t>(words.size(), UINT16_MAX));
+            index.totalLength += index.documentLengths[slot];
+
+            std::sort(words.begin(), words.end());
+            for (size_t i = 0; i < words.size();) {
+                size_t end = i;
+                while (end < words.size() && words[end] == words[i]) {
+                    end++;
+                }
+
+                TextIndex::Postings& postings = index.terms[item.category][words[i]];
+                appendVarint(postings.bytes, static_cast<uint32_t>(slot) - postings.lastSlot);
+                appendVarint(postings.bytes, static_cast<uint32_t>(end - i));
+                postings.lastSlot = static_cast<uint32_t>(slot);
+                postings.documentCount++;
+                i = end;
+            }
+        }
+
+        // Normalize all loaded items and rebuild all indexes (after loading)
+        void rebuildIndexes() {
+            lostIndex.clear();
+            foundIndex.clear();
+            lostText.clear();
+            foundText.clear();
+            lostTimes.clear();
+            foundTimes.clear();
+            standingQueries.clear();
+            lostColumns.clear();
+            foundColumns.clear();
+            rollups.clear();
+            idSlots.clear();
+            idOrder.clear();
+            lostUnindexed.clear();
+            foundUnindexed.clear();
+
+            for (bool isLost : {true, false}) {
+                std::vector<Item>& list = isLost ? lostItems : foundItems;
+                for (size_t i = 0; i < list.size(); i++) {
+                    Item& item = list[i];
+                    normalizeItem(item);
+                    idSlots[item.id] = {isLost, static_cast<uint32_t>(i)};
+                    if (ulidMillis(item.id) >= 0) {
+                        idOrder.emplace_back(item.id, ItemRef{isLost, static_cast<uint32_t>(i)});
+                    }
+                    indexText(isLost ? lostText : foundText, item, i);
+                    (isLost ? lostColumns : foundColumns).add(item, static_cast<uint32_t>(i));
+                    rollups.add(isLost, item, 1);
+                    if (isIndexed(item)) {
+                        indexItem(isLost ? lostIndex : foundIndex, item, i);
+                        (isLost ? lostTimes : foundTimes).entries[item.category].emplace_back(item.eventMinute, i);
+                    } else {
+                        (isLost ? lostUnindexed : foundUnindexed).push_back(static_cast<uint32_t>(i));
+                    }
+                }
+            }
+
+            for (auto* times : {&lostTimes, &foundTimes}) {
+                for (auto& pair : times->entries) {
+                    std::sort(pair.second.begin(), pair.second.end());
+                }
+            }
+            std::sort(idOrder.begin(), idOrder.end(), compareIdOrder);
+
+            for (size_t i = 0; i < lostItems.size(); i++) {
+                if (lostItems[i].status == ItemStatus::OPEN) {
+                    registerStandingQuery(lostItems[i], static_cast<uint32_t>(i));
+                }
+            }
+        }
+
+        // For a narrow time window, the slots (sorted) of the items in the
+        // query's category whose event time is within the window or unknown.
+        // Returns false when there is no window or it holds more than
+        // 1/WINDOW_SCAN_FRACTION of the category; the caller then goes
+        // through the attribute and text indexes instead.
+        bool windowCandidates(const TimeIndex& times, const MatchQuery& query, int64_t windowMinutes,
+                              std::vector<uint32_t>& slots) const {
+            if (windowMinutes <= 0 || query.eventMinute == NO_EVENT_TIME) {
+                return false;
+            }
+
+            auto categoryIt = times.entries.find(query.category);
+            if (categoryIt == times.entries.end()) {
+                slots.clear();
+                return true;
+            }
+            const auto& entries = categoryIt->second;
+
+            auto untimedEnd = std::upper_bound(entries.begin(), entries.end(), std::make_pair(NO_EVENT_TIME, UINT32_MAX));
+            auto first = std::lower_bound(untimedEnd, entries.end(),
+                                          std::make_pair(query.eventMinute - windowMinutes, 0u));
+            auto last = std::upper_bound(first, entries.end(),
+                                         std::make_pair(query.eventMinute + windowMinutes, UINT32_MAX));
+            const size_t count = static_cast<size_t>((untimedEnd - entries.begin()) + (last - first));
+            if (count * WINDOW_SCAN_FRACTION > entries.size()) {
+                return false;
+            }
+
+            slots.clear();
+            slots.reserve(count);
+            for (auto it = entries.begin(); it != untimedEnd; ++it) {
+                slots.push_back(it->second);
+            }
+            for (auto it = first; it != last; ++it) {
+                slots.push_back(it->second);
+            }
+            std::sort(slots.begin(), slots.end());
+            return true;
+        }
+
+        // BM25 scores of the items whose free text shares words with the
+        // query, as points (capped at TEXT_SCORE_MAX), sorted by slot. The
+        // query words' posting lists are merged document-at-a-time, so the
+        // hits come out in slot order without a sort.
+        std::vector<SearchResult> scoreText(const TextIndex& index, const MatchQuery& query) const {
+            std::vector<SearchResult> hits;
+            const size_t documents = index.documentLengths.size();
+            auto categoryIt = index.terms.find(query.category);
+            if (query.textTerms.empty() || categoryIt == index.terms.end() || index.totalLength == 0) {
+                return hits;
+            }
+
+            const double k1 = 1.2;
+            const double b = 0.75;
+            const double averageLength = static_cast<double>(index.totalLength) / documents;
+
+            // Read position in one word's posting list
+            struct Cursor {
+                const uint8_t* next;
+                const uint8_t* end;
+                double idf;
+                uint32_t slot = 0;
+                uint32_t frequency = 0;
+
+                bool advance() {
+                    if (next == end) {
+                        return false;
+                    }
+                    slot += readVarint(next);
+                    frequency = readVarint(next);
+                    return true;
+                }
+            };
+
+            std::vector<Cursor> cursors;
+            for (const auto& term : query.textTerms) {
+                auto it = categoryIt->second.find(term);
+                if (it == categoryIt->second.end()) {
+                    continue;
+                }
+
+                const TextIndex::Postings& postings = it->second;
+                const double df = postings.documentCount;
+                Cursor cursor{postings.bytes.data(), postings.bytes.data() + postings.bytes.size(),
+                              std::log(1.0 + (documents - df + 0.5) / (df + 0.5))};
+                if (cursor.advance()) {
+                    cursors.push_back(cursor);
+                }
+            }
+
+            while (!cursors.empty()) {
+                uint32_t slot = cursors[0].slot;
+                for (const auto& cursor : cursors) {
+                    slot = std::min(slot, cursor.slot);
+                }
+
+                const double lengthNorm = k1 * (1 - b + b * index.documentLengths[slot] / averageLength);
+                double score = 0.0;
+                for (size_t i = 0; i < cursors.size();) {
+                    Cursor& cursor = cursors[i];
+                    if (cursor.slot == slot) {
+                        score += cursor.idf * cursor.frequency * (k1 + 1) / (cursor.frequency + lengthNorm);
+                        if (!cursor.advance()) {
+                            cursors[i] = cursors.back();
+                            cursors.pop_back();
+                            continue;
+                        }
+                    }
+                    i++;
+                }
+
+                int points = static_cast<int>(std::lround(std::min<double>(score, TEXT_SCORE_MAX)));
+                if (points > 0) {
+                    hits.push_back({slot, points});
+                }
+            }
+            return hits;
+        }
+
+        // Collect the slots of items in the query's category whose value for
+        // some query attribute shares at least a third of that term's
+        // trigrams, so misspelled values still reach the scorer
+        std::vector<uint32_t> findCandidates(const AttributeIndex& index, const MatchQuery& query) const {
+            std::vector<uint32_t> candidates;
+
+            auto categoryIt = index.postings.find(query.category);
+            if (categoryIt == index.postings.end()) {
+                return candidates;
+            }
+
+            // Shared-trigram counts per slot, reused across calls on a thread
+            static thread_local std::vector<uint16_t> counts;
+
+            for (const auto& term : query.terms) {
+                std::vector<uint32_t> trigrams = valueTrigrams(term.text);
+                const size_t needed = std::max<size_t>(1, (trigrams.size() + 2) / 3);
+
+                for (uint32_t trigram : trigrams) {
+                    auto postingIt = categoryIt->second.find(indexKey(term.attribute, trigram));
+                    if (postingIt == categoryIt->second.end()) {
+                        continue;
+                    }
+                    for (uint32_t slot : postingIt->second) {
+                        if (slot >= counts.size()) {
+                            counts.resize(slot + 1);
+                        }
+                        if (++counts[slot] == needed) {
+                            candidates.push_back(slot);
+                        }
+                    }
+                }
+
+                // Reset only the counters this term touched
+                for (uint32_t trigram : trigrams) {
+                    auto postingIt = categoryIt->second.find(indexKey(term.attribute, trigram));
+                    if (postingIt != categoryIt->second.end()) {
+                        for (uint32_t slot : postingIt->second) {
+                            counts[slot] = 0;
+                        }
+                    }
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            return candidates;
+        }
+
+        // Find the best matches for a query: candidates from the index are
+        // scored into a bounded heap holding offset + limit slots, so only the
+        // requested page is ever sorted. totalMatches (optional) receives the
+        // number of items scoring at least options.minScore.
+        std::vector<SearchResult> findMatches(bool isLostItem, const MatchQuery& query,
+                                              const SearchOptions& options, size_t* totalMatches = nullptr) const {
+            Metrics::Timer timer(Metrics::SEARCH);
+            Metrics::add(Metrics::SEARCHES);
+            const std::vector<Item>& searchIn = isLostItem ? foundItems : lostItems;
+            const AttributeIndex& index = isLostItem ? foundIndex : lostIndex;
+
+            size_t total = 0;
+
+            // A narrow time window is read straight from the time index;
+            // otherwise candidates are the items sharing an attribute value
+            // or a free-text word with the search
+            std::vector<SearchResult> textHits = scoreText(isLostItem ? foundText : lostText, query);
+            std::vector<uint32_t> candidates;
+
+            // A search by location alone matches on location proximity
+            const bool locationOnly = query.terms.empty() && query.textTerms.empty();
+
+            if (options.resolvedOnly && indexOpenOnly) {
+                // The indexes hold no resolved items; take the few the store
+                // has from the list kept beside them
+                candidates = isLostItem ? foundUnindexed : lostUnindexed;
+            } else if (!windowCandidates(isLostItem ? foundTimes : lostTimes, query, options.windowMinutes, candidates)) {
+                candidates = locationOnly ? findNearby(index, query) : findCandidates(index, query);
+                if (!textHits.empty()) {
+                    for (const auto& hit : textHits) {
+                        candidates.push_back(hit.slot);
+                    }
+                    std::sort(candidates.begin(), candidates.end());
+                    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+                }
+            }
+
+            Metrics::record(Metrics::CANDIDATES_PER_SEARCH, candidates.size());
+            Metrics::Timer scoringTimer(Metrics::SEARCH_SCORING);
+            const size_t capacity = options.limit > SIZE_MAX - options.offset ? SIZE_MAX : options.offset + options.limit;
+            TopKCollector top(capacity, candidates.size());
+            size_t scored = 0;
+
+            const bool windowed = options.windowMinutes > 0 && query.eventMinute != NO_EVENT_TIME;
+            auto outsideWindow = [&](int64_t eventMinute) {
+                return windowed && eventMinute != NO_EVENT_TIME &&
+                       std::abs(eventMinute - query.eventMinute) > options.windowMinutes;
+            };
+            auto textHit = textHits.begin();
+            auto textScore = [&](uint32_t slot) {
+                while (textHit != textHits.end() && textHit->slot < slot) {
+                    ++textHit;
+                }
+                return textHit != textHits.end() && textHit->slot == slot ? textHit->score : 0;
+            };
+            auto offer = [&](uint32_t slot, int score) {
+                if (score >= options.minScore) {
+                    total++;
+                    top.offer(slot, score);
+                }
+            };
+
+            // When the candidates are a good part of the category, exact
+            // matches are scored for the whole category at once over the
+            // columns, and only the remaining values are compared fuzzily
+            const ScoringColumns& scoringColumns = isLostItem ? foundColumns : lostColumns;
+            const ScoringColumns::Category* columns = nullptr;
+            std::vector<ColumnTerm> columnTerms;
+            std::vector<const MatchQuery::Term*> columnQueryTerms;
+            auto columnsIt = scoringColumns.categories.find(query.category);
+            if (!locationOnly && columnsIt != scoringColumns.categories.end() &&
+                candidates.size() * WINDOW_SCAN_FRACTION >= columnsIt->second.slots.size()) {
+                columns = &columnsIt->second;
+                for (const auto& term : query.terms) {
+                    const uint32_t* values = columns->column(term.attribute);
+                    if (values && term.signature.count > 0) {
+                        columnTerms.push_back({values, term.value});
+                        columnQueryTerms.push_back(&term);
+                    }
+                }
+                if (columnTerms.size() > 31) {
+                    columns = nullptr;  // More terms than fuzzy bits
+                }
+            }
+
+            if (columns) {
+                static thread_local std::vector<uint32_t> exact;
+                static thread_local std::vector<uint32_t> fuzzy;
+                const size_t rowCount = columns->slots.size();
+                exact.resize(rowCount);
+                fuzzy.resize(rowCount);
+                exactScores(columnTerms.data(), columnTerms.size(), rowCount, exact.data(), fuzzy.data());
+
+                for (uint32_t slot : candidates) {
+                    const uint32_t row = scoringColumns.rows[slot];
+                    if (row >= rowCount || columns->slots[row] != slot) {
+                        continue;  // Another category
+                    }
+                    if ((options.openOnly && !columns->open[row]) || (options.resolvedOnly && columns->open[row]) ||
+                        outsideWindow(columns->eventMinutes[row])) {
+                        continue;
+                    }
+
+                    scored++;
+                    int score = static_cast<int>(exact[row]) + textScore(slot);
+                    for (uint32_t flags = fuzzy[row]; flags != 0; flags &= flags - 1) {
+                        const int t = __builtin_ctz(flags);
+                        const uint32_t value = columnTerms[t].values[row];
+                        score += valueScore(columnQueryTerms[t]->value, columnQueryTerms[t]->signature,
+                                            value, symbols.signature(value));
+                    }
+                    if (score == 0) {
+                        continue;
+                    }
+                    offer(slot, score + locationScore(query, columns->locationIds[row], columns->locationSymbols[row]));
+                }
+            } else {
+                for (uint32_t slot : candidates) {
+                    const Item& item = searchIn[slot];
+                    if ((options.openOnly && item.status != ItemStatus::OPEN) ||
+                        (options.resolvedOnly && item.status == ItemStatus::OPEN) || item.category != query.category) {
+                        continue;
+                    }
+                    if (outsideWindow(item.eventMinute)) {
+                        continue;
+                    }
+
+                    // Location alone does not make a match, unless that is
+                    // all the search has
+                    scored++;
+                    int score = detailScore(query, item) + textScore(slot);
+                    if (score == 0 && !locationOnly) {
+                        continue;
+                    }
+                    offer(slot, score + locationScore(query, item));
+                }
+            }
+
+            Metrics::add(Metrics::ITEMS_SCORED, scored);
+            if (totalMatches) {
+                *totalMatches = total;
+            }
+
+            std::vector<SearchResult> results = top.takeSorted();
+            if (options.offset >= results.size()) {
+                return {};
+            }
+            results.erase(results.begin(), results.begin() + options.offset);
+            return results;
+        }
+    };
+
+    LeftRight<ItemStore> store;
+
+    // Cold tier. Resolved (CLOSED/MATCHED) items are moved out of the store
+    // into the archive snapshots at startup; historical searches load the
+    // archive on first use and keep it until it is rewritten. Items resolved
+    // since startup are searched in the store itself (resolvedOnly).
+    mutable std::mutex archiveMutex;
+    mutable std::shared_ptr<const ItemStore> archiveCache;
+    Rollups archiveRollups;  // Counts of the archived items; set at startup
+
+    // Journal state. Every mutation is appended to JOURNAL_FILE as one
+    // "<OP>\t<json>" line; the JSON files are only rewritten by compaction.
+    int journalFd = -1;
+    size_t journalRecordCount = 0;      // Records since the last compaction
+    uint64_t journalWrittenSeq = 0;     // Records written so far
+    uint64_t journalSyncedSeq = 0;      // Records known to be on disk
+    bool journalSyncing = false;        // A writer is running the group fsync
+    std::atomic<int> journalAppenders{0};
+    std::mutex journalMutex;
+    std::condition_variable journalCv;
+    std::thread journalWorker;
+    bool journalStopping = false;
+    bool compactionPending = false;
+
+    // Called with (lost report, new found item, score) when a found item
+    // satisfies an open lost report's standing query
+    using MatchCallback = std::function<void(const Item&, const Item&, int)>;
+    std::mutex subscribersMutex;
+    std::vector<MatchCallback> subscribers;
+
+    // Look up a category by its display name; false if there is none
+    static bool findCategory(std::string_view name, ItemCategory& category) {
+        for (size_t i = 0; i < CATEGORY_COUNT; i++) {
+            if (CATEGORY_SCHEMAS[i].name == name) {
+                category = static_cast<ItemCategory>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Look up a category by its display name (OTHER if unknown)
+    static ItemCategory categoryFromName(std::string_view name) {
+        ItemCategory category = ItemCategory::OTHER;
+        findCategory(name, category);
+        return category;
+    }
+
+    // Look up a status by name (OPEN if unknown)
+    static ItemStatus statusFromName(std::string_view name) {
+        for (const auto& pair : statusNames) {
+            if (pair.second == name) {
+                return pair.first;
+            }
+        }
+        return ItemStatus::OPEN;
+    }
+
+    // Lowercase copy of a string
+    static std::string toLower(std::string_view text) {
+        std::string lower(text);
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return lower;
+    }
+
+    // Get user input with prompt
+    std::string getInput(const std::string& prompt) {
+        std::string input;
+        std::cout << prompt;
+        std::getline(std::cin, input);
+        return input;
+    }
+
+    // Get integer input with validation
+    int getIntInput(const std::string& prompt, int min, int max) {
+        int input;
+        std::string line;
+        bool valid = false;
+
+        while (!valid) {
+            std::cout << prompt;
+            std::getline(std::cin, line);
+
+            try {
+                input = std::stoi(line);
+                if (input >= min && input <= max) {
+                    valid = true;
+                } else {
+                    std::cout << "Please enter a number between " << min << " and " << max << std::endl;
+                }
+            } catch (const std::exception& e) {
+                std::cout << "Invalid input. Please enter a number." << std::endl;
+            }
+        }
+
+        return input;
+    }
+
+    // Get item category from user
+    ItemCategory getItemCategory() {
+        std::cout << "\nSelect item category:" << std::endl;
+        for (size_t i = 0; i < CATEGORY_COUNT; i++) {
+            std::cout << (i + 1) << ". " << CATEGORY_SCHEMAS[i].name << std::endl;
+        }
+
+        int choice = getIntInput("Enter category number: ", 1, CATEGORY_COUNT);
+        return static_cast<ItemCategory>(choice - 1);
+    }
+
+    // Get timestamp from user input
+    std::string getDateTime(const std::string& prompt) {
+        std::string dateTimeStr;
+        bool validFormat = false;
+
+        while (!validFormat) {
+            dateTimeStr = getInput(prompt + " (YYYY-MM-DD HH:MM): ");
+
+            if (isValidDateTime(dateTimeStr)) {
+                validFormat = true;
+            } else {
+                std::cout << "Invalid format. Please use YYYY-MM-DD HH:MM format." << std::endl;
+            }
+        }
+
+        return dateTimeStr;
+    }
+
+    // Parse a "YYYY-MM-DD HH:MM" time into minutes since 1970-01-01 00:00
+    // (NO_EVENT_TIME if malformed). Times are compared with each other
+    // only, so no time zone is applied.
+    static int64_t parseEventMinute(std::string_view text) {
+        if (text.size() != 16 || text[4] != '-' || text[7] != '-' || text[10] != ' ' || text[13] != ':') {
+            return NO_EVENT_TIME;
+        }
+
+        auto number = [&](size_t pos, size_t length, int64_t& value) {
+            value = 0;
+            for (size_t i = pos; i < pos + length; i++) {
+                if (!std::isdigit(static_cast<unsigned char>(text[i]))) {
+                    return false;
+                }
+                value = value * 10 + (text[i] - '0');
+            }
+            return true;
+        };
+
+        int64_t year, month, day, hour, minute;
+        if (!number(0, 4, year) || !number(5, 2, month) || !number(8, 2, day) ||
+            !number(11, 2, hour) || !number(14, 2, minute) ||
+            month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59) {
+            return NO_EVENT_TIME;
+        }
+
+        // Days since the epoch for a proleptic Gregorian date
+        year -= month <= 2;
+        const int64_t era = year / 400;
+        const int64_t yearOfEra = year - era * 400;
+        const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        const int64_t days = era * 146097 + dayOfEra - 719468;
+
+        return (days * 24 + hour) * 60 + minute;
+    }
+
+    // Simple "YYYY-MM-DD HH:MM" format validation
+    static bool isValidDateTime(std::string_view dateTimeStr) {
+        return parseEventMinute(dateTimeStr) != NO_EVENT_TIME;
+    }
+
+    // Get item details based on category
+    std::map<std::string, std::string> getItemDetails(ItemCategory category) {
+        std::map<std::string, std::string> details;
+        std::cout << "\nPlease provide details about the " << categoryName(category) << ":" << std::endl;
+
+        for (const auto& attribute : categorySchema(category)) {
+            // Format attribute name for display (replace underscores with spaces)
+            std::string displayName(attribute);
+            std::replace(displayName.begin(), displayName.end(), '_', ' ');
+
+            // Capitalize first letter
+            if (!displayName.empty()) {
+                displayName[0] = std::toupper(displayName[0]);
+            }
+
+            std::string value = getInput(displayName + ": ");
+            details[std::string(attribute)] = value;
+        }
+
+        return details;
+    }
+
+    // IDs are ULIDs: a 48-bit Unix time in milliseconds and 80 random
+    // bits, as 26 Crockford base32 characters, so they sort by creation
+    // time. Each thread seeds its own generator once; ids a thread makes
+    // in the same millisecond increment the random part, so they stay
+    // ordered and distinct.
+    static std::string generateId() {
+        struct Generator {
+            std::mt19937_64 random;
+            uint64_t lastMillis = 0;
+            unsigned __int128 entropy = 0;  // Low 80 bits used
+        };
+        thread_local Generator generator = [] {
+            std::random_device rd;
+            std::seed_seq seed{rd(), rd(), rd(), rd()};
+            return Generator{std::mt19937_64(seed)};
+        }();
+
+        const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        const unsigned __int128 mask = (static_cast<unsigned __int128>(1) << ULID_RANDOM_BITS) - 1;
+        if (now > generator.lastMillis) {
+            generator.lastMillis = now;
+            generator.entropy = ((static_cast<unsigned __int128>(generator.random()) << 64) | generator.random()) & mask;
+        } else {
+            // Same millisecond, or the clock stepped back
+            generator.entropy = (generator.entropy + 1) & mask;
+        }
+
+        unsigned __int128 value = (static_cast<unsigned __int128>(generator.lastMillis) << ULID_RANDOM_BITS) |
+                                  generator.entropy;
+        std::string id(ULID_LENGTH, '0');
+        for (size_t i = ULID_LENGTH; i-- > 0;) {
+            id[i] = ULID_ALPHABET[static_cast<size_t>(value & 31)];
+            value >>= 5;
+        }
+        return id;
+    }
+
+    static constexpr size_t ULID_LENGTH = 26;
+    static constexpr int ULID_RANDOM_BITS = 80;
+    static constexpr const char* ULID_ALPHABET = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+    // Creation time of a ULID in Unix milliseconds, or -1 for ids that are
+    // not ULIDs (such as those made before ULIDs were used)
+    static int64_t ulidMillis(std::string_view id) {
+        if (id.size() != ULID_LENGTH || id[0] > '7') {
+            return -1;
+        }
+        int64_t millis = 0;
+        for (char c : id.substr(0, 10)) {
+            const char* digit = std::strchr(ULID_ALPHABET, c);
+            if (c == '\0' || !digit) {
+                return -1;
+            }
+            millis = (millis << 5) | (digit - ULID_ALPHABET);
+        }
+        return millis;
+    }
+
+    // Get current timestamp as string
+    std::string getCurrentTimestamp() {
+        auto now = std::chrono::system_clock::now();
+        auto now_c = std::chrono::system_clock::to_time_t(now);
+
+        std::tm local{};
+        ::localtime_r(&now_c, &local);
+
+        std::stringstream ss;
+        ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
+        return ss.str();
+    }
+
+    // Single-pass JSON tokenizer over an in-memory buffer. Strings are
+    // decoded as they are read, so everything escapeJsonString writes
+    // round-trips exactly.
+    class JsonReader {
+    public:
+        explicit JsonReader(std::string_view input) : text(input) {}
+
+        // Byte offset of the next unread character (for error reporting)
+        size_t position() const {
+            return pos;
+        }
+
+        bool atEnd() {
+            skipWhitespace();
+            return pos >= text.size();
+        }
+
+        // Consume the given structural character if it is next
+        bool consume(char expected) {
+            skipWhitespace();
+            if (pos < text.size() && text[pos] == expected) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+
+        // Read a string literal, decoding escape sequences into out
+        bool readString(std::string& out) {
+            out.clear();
+            if (!consume('"')) {
+                return false;
+            }
+
+            while (pos < text.size()) {
+                // Copy the run up to the next quote or escape in one go
+                size_t runEnd = pos;
+                while (runEnd < text.size() && text[runEnd] != '"' && text[runEnd] != '\\') {
+                    runEnd++;
+                }
+                out.append(text.data() + pos, runEnd - pos);
+                pos = runEnd;
+
+                if (pos >= text.size()) {
+                    break;
+                }
+                if (text[pos] == '"') {
+                    pos++;
+                    return true;
+                }
+
+                // Escape sequence
+                if (++pos >= text.size()) {
+                    break;
+                }
+                char c = text[pos++];
+                switch (c) {
+                    case '"': out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/': out += '/'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': {
+                        unsigned int codePoint;
+                        if (!readHex4(codePoint)) {
+                            return false;
+                        }
+                        // Combine UTF-16 surrogate pairs
+                        if (codePoint >= 0xD800 && codePoint <= 0xDBFF &&
+                            pos + 1 < text.size() && text[pos] == '\\' && text[pos + 1] == 'u') {
+                            pos += 2;
+                            unsigned int low;
+                            if (!readHex4(low)) {
+                                return false;
+                            }
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        appendUtf8(out, codePoint);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+
+            return false;  // Unterminated string
+        }
+
+        // Read an object, calling onMember(key) for each member; the
+        // callback must consume the member's value
+        template <typename Callback>
+        bool readObject(Callback&& onMember) {
+            if (!consume('{')) {
+                return false;
+            }
+            if (consume('}')) {
+                return true;
+            }
+
+            std::string key;
+            do {
+                if (!readString(key) || !consume(':') || !onMember(key)) {
+                    return false;
+                }
+            } while (consume(','));
+
+            return consume('}');
+        }
+
+        // Read an array, calling onElement() for each element; the
+        // callback must consume the element
+        template <typename Callback>
+        bool readArray(Callback&& onElement) {
+            if (!consume('[')) {
+                return false;
+            }
+            if (consume(']')) {
+                return true;
+            }
+
+            do {
+                if (!onElement()) {
+                    return false;
+                }
+            } while (consume(','));
+
+            return consume(']');
+        }
+
+        // Read an integer number
+        bool readInteger(long long& value) {
+            skipWhitespace();
+            size_t start = pos;
+            if (pos < text.size() && text[pos] == '-') {
+                pos++;
+            }
+            while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+            if (pos == start) {
+                return false;
+            }
+            try {
+                value = std::stoll(std::string(text.substr(start, pos - start)));
+            } catch (const std::exception&) {
+                return false;
+            }
+            return true;
+        }
+
+        // Read true or false
+        bool readBool(bool& value) {
+            skipWhitespace();
+            for (std::string_view literal : {std::string_view("true"), std::string_view("false")}) {
+                if (text.substr(pos, literal.size()) == literal) {
+                    value = (literal == "true");
+                    pos += literal.size();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Skip over any value (used for unknown keys)
+        bool skipValue() {
+            skipWhitespace();
+            if (pos >= text.size()) {
+                return false;
+            }
+
+            switch (text[pos]) {
+                case '"': {
+                    std::string ignored;
+                    return readString(ignored);
+                }
+                case '{':
+                    return readObject([this](const std::string&) { return skipValue(); });
+                case '[':
+                    return readArray([this]() { return skipValue(); });
+                default: {
+                    // Number, true, false or null
+                    size_t start = pos;
+                    while (pos < text.size() && text[pos] != ',' && text[pos] != '}' &&
+                           text[pos] != ']' && !std::isspace(static_cast<unsigned char>(text[pos]))) {
+                        pos++;
+                    }
+                    return pos > start;
+                }
+            }
+        }
+
+    private:
+        std::string_view text;
+        size_t pos = 0;
+
+        void skipWhitespace() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+        }
+
+        bool readHex4(unsigned int& value) {
+            if (pos + 4 > text.size()) {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < 4; i++) {
+                char c = text[pos++];
+                value <<= 4;
+                if (c >= '0' && c <= '9') {
+                    value |= c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    value |= c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    value |= c - 'A' + 10;
+                } else {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static void appendUtf8(std::string& out, unsigned int codePoint) {
+            if (codePoint < 0x80) {
+                out += static_cast<char>(codePoint);
+            } else if (codePoint < 0x800) {
+                out += static_cast<char>(0xC0 | (codePoint >> 6));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else if (codePoint < 0x10000) {
+                out += static_cast<char>(0xE0 | (codePoint >> 12));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (codePoint >> 18));
+                out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+    };
+
+    // Read a whole file into memory with a single read
+    static bool readFileContents(const std::string& filename, std::string& content) {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        std::streamsize size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        content.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        if (size > 0 && !file.read(&content[0], size)) {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Load predefined locations from JSON file. Records either name a
+    // location directly ("name", "roomNumber") or place it in the hierarchy
+    // ("buildingName", "floorNumber"), with an optional "description".
+    void loadLocations() {
+        predefinedLocations.clear();
+
+        std::string content;
+        if (!readFileContents(LOCATIONS_FILE, content)) {
+            std::cerr << "Failed to open locations file: " << LOCATIONS_FILE << std::endl;
+            return;
+        }
+
+        JsonReader reader(content);
+        if (reader.atEnd()) {
+            return;
+        }
+
+        bool ok = reader.readArray([&]() {
+            Location loc;
+            bool parsed = reader.readObject([&](const std::string& key) {
+                if (key == "name") {
+                    return reader.readString(loc.name);
+                } else if (key == "roomNumber") {
+                    return reader.readString(loc.roomNumber);
+                } else if (key == "description") {
+                    return reader.readString(loc.description);
+                } else if (key == "buildingName" || key == "building") {
+                    return reader.readString(loc.building);
+                } else if (key == "floorNumber" || key == "floor") {
+                    return reader.readString(loc.floor);
+                }
+                return reader.skipValue();
+            });
+            if (parsed) {
+                if (loc.name.empty()) {
+                    loc.name = loc.building;
+                    if (!loc.floor.empty()) {
+                        loc.name += " Floor " + loc.floor;
+                    }
+                    if (!loc.description.empty()) {
+                        loc.name += (loc.name.empty() ? "" : " - ") + loc.description;
+                    }
+                }
+                if (loc.building.empty()) {
+                    loc.building = loc.name;
+                }
+                predefinedLocations.push_back(std::move(loc));
+            }
+            return parsed;
+        });
+
+        if (!ok) {
+            std::cerr << "Malformed locations file " << LOCATIONS_FILE
+                      << " near offset " << reader.position() << std::endl;
+        }
+    }
+
+    // Get location from user with predefined options
+    std::string getLocation() {
+        std::cout << "\nSelect location:" << std::endl;
+        std::cout << "1. Choose from predefined locations" << std::endl;
+        std::cout << "2. Enter custom location" << std::endl;
+
+        int choice = getIntInput("Enter your choice: ", 1, 2);
+
+        if (choice == 1) {
+            if (predefinedLocations.empty()) {
+                std::cout << "No predefined locations available. Please enter a custom location." << std::endl;
+                return getInput("Enter location: ");
+            }
+
+            std::cout << "\nAvailable locations:" << std::endl;
+            for (size_t i = 0; i < predefinedLocations.size(); i++) {
+                std::cout << (i + 1) << ". " << predefinedLocations[i].label() << std::endl;
+            }
+
+            int locChoice = getIntInput("Select location: ", 1, predefinedLocations.size());
+            return predefinedLocations[locChoice - 1].label();
+        } else {
+            return getInput("Enter location: ");
+        }
+    }
+
+    // Initialize data directory and files
+    void initDataStorage() {
+        try {
+            // Create data directory if it doesn't exist
+            if (!std::filesystem::exists(DATA_DIR)) {
+                std::filesystem::create_directory(DATA_DIR);
+            }
+
+            // Create files if they don't exist
+            if (!std::filesystem::exists(LOST_ITEMS_FILE)) {
+                std::ofstream file(LOST_ITEMS_FILE);
+                file << "[]";
+                file.close();
+            }
+
+            if (!std::filesystem::exists(FOUND_ITEMS_FILE)) {
+                std::ofstream file(FOUND_ITEMS_FILE);
+                file << "[]";
+                file.close();
+            }
+
+            if (!std::filesystem::exists(LOCATIONS_FILE)) {
+                std::ofstream file(LOCATIONS_FILE);
+                file << "[]";
+                file.close();
+            }
+
+            // Load existing data, then replay whatever the journal holds
+            // beyond the last compacted snapshot, and publish the result
+            loadLocations();
+
+            ItemStore loaded;
+            loaded.locations.build(predefinedLocations);
+            loadItems(loaded);
+            replayJournal(loaded);
+            loadArchiveRollups(loaded.locations);
+            size_t archived = archiveResolvedItems(loaded);
+            loaded.rebuildIndexes();
+            store.reset(loaded);
+
+            // A crash mid-compaction leaves the rotated journal behind. Its
+            // records are replayed above; fold them into the snapshots and
+            // drop it, or it would block compaction and replay forever. The
+            // live journal stays: replaying it on top is harmless.
+            if (std::filesystem::exists(COMPACTING_JOURNAL_FILE) && writeSnapshots()) {
+                std::filesystem::remove(COMPACTING_JOURNAL_FILE);
+            }
+            openJournal();
+
+            // Drop the archived items from the hot files
+            if (archived > 0) {
+                checkpoint();
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error initializing data storage: " << e.what() << std::endl;
+        }
+    }
+
+    // Move resolved items from the loaded lists into the archive. Each run
+    // appends one segment, so what is archived already is never read back
+    // or rewritten, and adds the moved items to archiveRollups. Items stay
+    // in the hot lists if their segment cannot be written. Returns the
+    // number moved.
+    size_t archiveResolvedItems(ItemStore& loaded) {
+        size_t moved = 0;
+        for (bool isLost : {true, false}) {
+            std::vector<Item>& items = isLost ? loaded.lostItems : loaded.foundItems;
+            auto isResolved = [](const Item& item) { return item.status != ItemStatus::OPEN; };
+            if (std::none_of(items.begin(), items.end(), isResolved)) {
+                continue;
+            }
+
+            // A crash before the hot files were rewritten leaves the last
+            // run's items in them as well; those are in the newest segment
+            const size_t segments = archiveSegmentCount(isLost);
+            MappedSnapshot newest;
+            std::unordered_set<std::string_view> archivedIds;
+            if (segments > 0 && newest.open(archiveSegmentFile(isLost, segments - 1))) {
+                for (size_t i = 0; i < newest.size(); i++) {
+                    archivedIds.insert(newest.item(i).id());
+                }
+            }
+            std::vector<Item> segment;
+            for (const auto& item : items) {
+                if (isResolved(item) && archivedIds.insert(item.id).second) {
+                    segment.push_back(item);
+                }
+            }
+
+            // The write is atomic, so a crash never leaves a torn segment
+            if (!segment.empty()) {
+                const std::string segmentFile = archiveSegmentFile(isLost, segments);
+                if (!saveBinarySnapshot(segmentFile, segment)) {
+                    std::cerr << "Failed to write archive " << segmentFile << "; keeping resolved items loaded" << std::endl;
+                    continue;
+                }
+                for (Item& item : segment) {
+                    loaded.normalizeItem(item);
+                    archiveRollups.add(isLost, item, 1);
+                }
+            }
+
+            auto resolved = std::remove_if(items.begin(), items.end(), isResolved);
+            moved += static_cast<size_t>(items.end() - resolved);
+            items.erase(resolved, items.end());
+        }
+
+        if (moved > 0) {
+            saveArchiveRollups();
+            std::lock_guard<std::mutex> lock(archiveMutex);
+            archiveCache.reset();
+        }
+        return moved;
+    }
+
+    // The archive of each list is a chain of segment snapshots: the base
+    // file, then lost_archive.1.snap and so on, one per archiving run
+    std::string archiveSegmentFile(bool isLost, size_t segment) const {
+        const std::string& base = isLost ? LOST_ARCHIVE_FILE : FOUND_ARCHIVE_FILE;
+        if (segment == 0) {
+            return base;
+        }
+        return base.substr(0, base.size() - std::strlen(".snap")) + "." + std::to_string(segment) + ".snap";
+    }
+
+    // Number of segments in a list's archive (they are numbered without gaps)
+    size_t archiveSegmentCount(bool isLost) const {
+        size_t segments = 0;
+        while (std::filesystem::exists(archiveSegmentFile(isLost, segments))) {
+            segments++;
+        }
+        return segments;
+    }
+
+    // Number of items in a list's archive, from the segment headers
+    uint64_t archivedItemCount(bool isLost) const {
+        uint64_t count = 0;
+        const size_t segments = archiveSegmentCount(isLost);
+        for (size_t i = 0; i < segments; i++) {
+            MappedSnapshot segment;
+            if (segment.open(archiveSegmentFile(isLost, i))) {
+                count += segment.size();
+            }
+        }
+        return count;
+    }
+
+    // Archive rollups file: the archives' item counts, to spot a file left
+    // stale by a crash between the archive and rollup writes, then one
+    // record per (series, event hour)
+    static constexpr char ROLLUPS_MAGIC[8] = {'L', 'F', 'B', 'R', 'O', 'L', 'L', '1'};
+
+    struct RollupsHeader {
+        char magic[8];
+        uint64_t lostCount;
+        uint64_t foundCount;
+        uint64_t recordCount;
+    };
+
+    struct RollupRecord {
+        uint64_t key;
+        int64_t hour;
+        uint64_t count;
+    };
+
+    // Load the archived items' rollups, so counting resolved items never
+    // loads the archive. They are rebuilt from the archive (and saved)
+    // only when the file is missing or was written for other archive
+    // contents, as after a crash between a segment and rollups write.
+    void loadArchiveRollups(const LocationGraph& locations) {
+        archiveRollups.clear();
+        const uint64_t lostCount = archivedItemCount(true);
+        const uint64_t foundCount = archivedItemCount(false);
+        if (lostCount + foundCount == 0 || readArchiveRollups(lostCount, foundCount)) {
+            return;
+        }
+
+        ItemStore archive;
+        archive.locations = locations;
+        for (bool isLost : {true, false}) {
+            std::vector<Item>& items = isLost ? archive.lostItems : archive.foundItems;
+            loadArchiveItems(isLost, items);
+            for (Item& item : items) {
+                archive.normalizeItem(item);
+                archiveRollups.add(isLost, item, 1);
+            }
+        }
+        saveArchiveRollups();
+    }
+
+    // Persist archiveRollups with the archives' current item counts
+    void saveArchiveRollups() const {
+        std::vector<RollupRecord> records;
+        for (const auto& series : archiveRollups.series) {
+            for (const auto& hour : series.second) {
+                records.push_back({series.first, hour.first, hour.second});
+            }
+        }
+        RollupsHeader header{};
+        std::memcpy(header.magic, ROLLUPS_MAGIC, sizeof(ROLLUPS_MAGIC));
+        header.lostCount = archivedItemCount(true);
+        header.foundCount = archivedItemCount(false);
+        header.recordCount = records.size();
+        if (!writeFileAtomically(ARCHIVE_ROLLUPS_FILE, {
+                std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)),
+                std::string_view(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(RollupRecord))})) {
+            std::cerr << "Failed to write " << ARCHIVE_ROLLUPS_FILE << std::endl;
+        }
+    }
+
+    // Read the archive rollups file if it matches the archives' item counts
+    bool readArchiveRollups(uint64_t lostCount, uint64_t foundCount) {
+        std::ifstream file(ARCHIVE_ROLLUPS_FILE, std::ios::binary);
+        RollupsHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, ROLLUPS_MAGIC, sizeof(ROLLUPS_MAGIC)) != 0 ||
+            header.lostCount != lostCount || header.foundCount != foundCount) {
+            return false;
+        }
+
+        std::vector<RollupRecord> records(header.recordCount);
+        if (!file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(RollupRecord))) {
+            archiveRollups.clear();
+            return false;
+        }
+        for (const auto& record : records) {
+            archiveRollups.series[record.key][record.hour] = static_cast<uint32_t>(record.count);
+        }
+        return true;
+    }
+
+    // Read every segment of a list's archive (a missing archive is empty)
+    void loadArchiveItems(bool isLost, std::vector<Item>& items) const {
+        const size_t segments = archiveSegmentCount(isLost);
+        for (size_t i = 0; i < segments; i++) {
+            const std::string segmentFile = archiveSegmentFile(isLost, i);
+            MappedSnapshot snapshot;
+            if (!snapshot.open(segmentFile)) {
+                std::cerr << "Ignoring unreadable archive: " << segmentFile << std::endl;
+                continue;
+            }
+            snapshot.readItems(items);
+        }
+    }
+
+    // The archived items as a searchable store, loaded on first use
+    std::shared_ptr<const ItemStore> archiveStore() const {
+        std::lock_guard<std::mutex> lock(archiveMutex);
+        if (!archiveCache) {
+            auto archive = std::make_shared<ItemStore>();
+            archive->indexOpenOnly = false;
+            store.read([&](const ItemStore& current) {
+                archive->attributeIds = current.attributeIds;
+                archive->attributeNames = current.attributeNames;
+                archive->locations = current.locations;
+            });
+            loadArchiveItems(true, archive->lostItems);
+            loadArchiveItems(false, archive->foundItems);
+            archive->rebuildIndexes();
+            archiveCache = archive;
+        }
+        return archiveCache;
+    }
+
+    // Load items from storage files
+    void loadItems(ItemStore& loaded) {
+        Metrics::Timer timer(Metrics::LOAD_ITEMS);
+        loaded.lostItems.clear();
+        loaded.foundItems.clear();
+
+        loadItemsPreferSnapshot(LOST_ITEMS_FILE, LOST_SNAPSHOT_FILE, loaded.lostItems);
+        loadItemsPreferSnapshot(FOUND_ITEMS_FILE, FOUND_SNAPSHOT_FILE, loaded.foundItems);
+        Metrics::add(Metrics::ITEMS_LOADED, loaded.lostItems.size() + loaded.foundItems.size());
+    }
+
+    // Load from the binary snapshot when it is at least as new as the JSON
+    // file it was written with, otherwise parse the JSON
+    void loadItemsPreferSnapshot(const std::string& jsonFile, const std::string& snapshotFile,
+                                 std::vector<Item>& items) {
+        if (BINARY_SNAPSHOTS_ENABLED && isSnapshotCurrent(jsonFile, snapshotFile)) {
+            MappedSnapshot snapshot;
+            if (snapshot.open(snapshotFile)) {
+                snapshot.readItems(items);
+                return;
+            }
+            std::cerr << "Ignoring unreadable snapshot: " << snapshotFile << std::endl;
+        }
+
+        loadItemsFromFile(jsonFile, items);
+    }
+
+    // Check whether a snapshot was written no earlier than its JSON file
+    static bool isSnapshotCurrent(const std::string& jsonFile, const std::string& snapshotFile) {
+        std::error_code ec;
+        auto snapshotTime = std::filesystem::last_write_time(snapshotFile, ec);
+        if (ec) {
+            return false;
+        }
+        auto jsonTime = std::filesystem::last_write_time(jsonFile, ec);
+        return ec || snapshotTime >= jsonTime;
+    }
+
+    // Load items from a specific file in a single forward pass
+    static void loadItemsFromFile(const std::string& filename, std::vector<Item>& items) {
+        Metrics::Timer timer(Metrics::PARSE_FILE);
+        std::string content;
+        if (!readFileContents(filename, content)) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return;
+        }
+        Metrics::add(Metrics::BYTES_PARSED, content.size());
+
+        JsonReader reader(content);
+        if (reader.atEnd()) {
+            return;
+        }
+
+        // The file's items share one arena
+        auto arena = std::make_shared<StringArena>();
+        bool ok = reader.readArray([&]() {
+            items.emplace_back();
+            items.back().text = arena;
+            return parseItem(reader, items.back(), *arena);
+        });
+
+        if (!ok) {
+            // Keep everything before the damaged record
+            if (!items.empty() && items.back().id.empty()) {
+                items.pop_back();
+            }
+            std::cerr << "Malformed item file " << filename
+                      << " near offset " << reader.position() << std::endl;
+        }
+    }
+
+    // Parse one item object from the reader directly into item, storing
+    // its text in arena (which the caller makes the item's)
+    static bool parseItem(JsonReader& reader, Item& item, StringArena& arena) {
+        return reader.readObject([&](const std::string& key) {
+            return parseItemMember(reader, item, key, arena);
+        });
+    }
+
+    // Parse the value of one item member (unknown keys are skipped)
+    static bool parseItemMember(JsonReader& reader, Item& item, const std::string& key, StringArena& arena) {
+        // Values are decoded into a reused buffer, then copied to the arena
+        thread_local std::string value;
+
+        if (key == "details") {
+            return reader.readObject([&](const std::string& detailKey) {
+                if (!reader.readString(value)) {
+                    return false;
+                }
+                item.details.set(arena.store(detailKey), arena.store(value));
+                return true;
+            });
+        }
+
+        if (key == "category" || key == "status") {
+            std::string name;
+            if (!reader.readString(name)) {
+                return false;
+            }
+            if (key == "category") {
+                item.category = categoryFromName(name);
+            } else {
+                item.status = statusFromName(name);
+            }
+            return true;
+        }
+
+        if (auto field = itemField(key)) {
+            if (!reader.readString(value)) {
+                return false;
+            }
+            item.*field = arena.store(value);
+            return true;
+        }
+        return reader.skipValue();
+    }
+
+    // Map a JSON key to the corresponding text field of an item
+    static std::string_view Item::*itemField(std::string_view key) {
+        if (key == "id") return &Item::id;
+        if (key == "personName") return &Item::personName;
+        if (key == "contactInfo") return &Item::contactInfo;
+        if (key == "eventTime") return &Item::eventTime;
+        if (key == "location") return &Item::location;
+        if (key == "reportTime") return &Item::reportTime;
+        if (key == "additionalInfo") return &Item::additionalInfo;
+        return nullptr;
+    }
+
+    // Parse a single JSON object into an Item (empty id on malformed input)
+    Item parseItemJson(std::string_view json) {
+        Item item;
+        JsonReader reader(json);
+        if (!parseItem(reader, item, item.writableText())) {
+            item.id = {};
+        }
+        return item;
+    }
+
+    // Convert item to JSON string
+    static std::string itemToJson(const Item& item) {
+        std::string json;
+        appendItemJson(json, item);
+        return json;
+    }
+
+    // Append an item's JSON to out
+    static void appendItemJson(std::string& out, const Item& item) {
+        auto member = [&](const char* key, std::string_view value, const char* separator) {
+            out += "\"";
+            out += key;
+            out += "\":\"";
+            appendJsonEscaped(out, value);
+            out += "\"";
+            out += separator;
+        };
+
+        out += "{";
+        member("id", item.id, ",");
+        member("personName", item.personName, ",");
+        member("contactInfo", item.contactInfo, ",");
+        member("category", categoryName(item.category), ",");
+        member("eventTime", item.eventTime, ",");
+        member("location", item.location, ",");
+        member("reportTime", item.reportTime, ",");
+
+        out += "\"details\":{";
+        bool first = true;
+        for (const auto& detail : item.details) {
+            if (!first) {
+                out += ",";
+            }
+            out += "\"";
+            appendJsonEscaped(out, detail.first);
+            out += "\":\"";
+            appendJsonEscaped(out, detail.second);
+            out += "\"";
+            first = false;
+        }
+        out += "},";
+
+        member("additionalInfo", item.additionalInfo, ",");
+        member("status", statusNames.at(item.status), "");
+        out += "}";
+    }
+
+    // Escape special characters in JSON string
+    static std::string escapeJsonString(std::string_view input) {
+        std::string output;
+        appendJsonEscaped(output, input);
+        return output;
+    }
+
+    static void appendJsonEscaped(std::string& output, std::string_view input) {
+        for (char c : input) {
+            switch (c) {
+                case '\"': output += "\\\""; break;
+                case '\\': output += "\\\\"; break;
+                case '\b': output += "\\b"; break;
+                case '\f': output += "\\f"; break;
+                case '\n': output += "\\n"; break;
+                case '\r': output += "\\r"; break;
+                case '\t': output += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 32) {
+                        // Control characters
+                        char buf[8];
+                        sprintf(buf, "\\u%04x", c);
+                        output += buf;
+                    } else {
+                        output += c;
+                    }
+            }
+        }
+    }
+
+    // Save items to files. The lists are copied out in short reads and
+    // written afterwards, so a slow disk holds up neither searches nor
+    // reports. Returns false if either snapshot could not be written.
+    bool saveItems() {
+        return writeSnapshots();
+    }
+
+    // Save items to a specific file
+    static bool saveItemsToFile(const std::string& filename, const std::vector<Item>& items) {
+        Metrics::Timer timer(Metrics::SAVE_ITEMS);
+        Metrics::add(Metrics::ITEMS_SAVED, items.size());
+
+        std::string json = "[";
+        for (size_t i = 0; i < items.size(); i++) {
+            if (i > 0) {
+                json += ",";
+            }
+            appendItemJson(json, items[i]);
+        }
+        json += "]";
+
+        return writeFileAtomically(filename, {json});
+    }
+
+    // Replace a file so that a crash leaves either the old or the new
+    // contents: write a temporary file beside it, fsync, rename it into
+    // place and fsync the directory
+    static bool writeFileAtomically(const std::string& filename, std::initializer_list<std::string_view> parts) {
+        const std::string tempFile = filename + ".tmp";
+        int fd = ::open(tempFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::cerr << "Failed to open file for writing: " << tempFile << std::endl;
+            return false;
+        }
+
+        bool ok = true;
+        for (std::string_view part : parts) {
+            while (ok && !part.empty()) {
+                ssize_t written = ::write(fd, part.data(), part.size());
+                if (written < 0 && errno != EINTR) {
+                    ok = false;
+                } else if (written > 0) {
+                    part.remove_prefix(static_cast<size_t>(written));
+                }
+            }
+        }
+        ok = ok && ::fsync(fd) == 0;
+        ok = (::close(fd) == 0) && ok;
+        if (!ok || ::rename(tempFile.c_str(), filename.c_str()) != 0) {
+            std::cerr << "Failed to write " << filename << ": " << std::strerror(errno) << std::endl;
+            ::unlink(tempFile.c_str());
+            return false;
+        }
+
+        std::string directory = std::filesystem::path(filename).parent_path().string();
+        int dirFd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+        return true;
+    }
+
+    // Binary snapshot layout. All integers are native-endian; strings
+    // live once in a deduplicated pool and are referenced by offset.
+    //
+    //   SnapshotHeader
+    //   SnapshotItemRecord[itemCount]      (offset table, fixed size)
+    //   SnapshotDetailRecord[detailCount]  (details of all items, in order)
+    //   string pool
+    struct SnapshotStringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t itemCount;
+        uint64_t itemsOffset;
+        uint64_t detailsOffset;
+        uint64_t detailCount;
+        uint64_t poolOffset;
+        uint64_t poolSize;
+    };
+
+    struct SnapshotItemRecord {
+        SnapshotStringRef id;
+        SnapshotStringRef personName;
+        SnapshotStringRef contactInfo;
+        SnapshotStringRef category;
+        SnapshotStringRef eventTime;
+        SnapshotStringRef location;
+        SnapshotStringRef reportTime;
+        SnapshotStringRef additionalInfo;
+        SnapshotStringRef status;
+        uint32_t detailsBegin;
+        uint32_t detailsCount;
+    };
+
+    struct SnapshotDetailRecord {
+        SnapshotStringRef key;
+        SnapshotStringRef value;
+    };
+
+    static constexpr char SNAPSHOT_MAGIC[8] = {'L', 'F', 'B', 'S', 'N', 'A', 'P', '1'};
+    static constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+    // Read-only view of one item inside a mapped snapshot. Accessors
+    // return views into the mapping, and so do the items toItem() makes.
+    class SnapshotItemView {
+    public:
+        SnapshotItemView(const SnapshotItemRecord* record, const SnapshotDetailRecord* details,
+                         const char* pool, uint64_t poolSize)
+            : record(record), details(details), pool(pool), poolSize(poolSize) {}
+
+        std::string_view id() const { return str(record->id); }
+        std::string_view personName() const { return str(record->personName); }
+        std::string_view contactInfo() const { return str(record->contactInfo); }
+        std::string_view category() const { return str(record->category); }
+        std::string_view eventTime() const { return str(record->eventTime); }
+        std::string_view location() const { return str(record->location); }
+        std::string_view reportTime() const { return str(record->reportTime); }
+        std::string_view additionalInfo() const { return str(record->additionalInfo); }
+        std::string_view status() const { return str(record->status); }
+
+        size_t detailCount() const { return record->detailsCount; }
+        std::string_view detailKey(size_t i) const { return str(details[i].key); }
+        std::string_view detailValue(size_t i) const { return str(details[i].value); }
+
+        // Look up a detail value by attribute name (empty if absent)
+        std::string_view detail(std::string_view key) const {
+            for (size_t i = 0; i < detailCount(); i++) {
+                if (detailKey(i) == key) {
+                    return detailValue(i);
+                }
+            }
+            return {};
+        }
+
+        // The item's text views the mapping; arena must keep it mapped
+        Item toItem(const std::shared_ptr<StringArena>& arena) const {
+            Item item;
+            item.id = id();
+            item.personName = personName();
+            item.contactInfo = contactInfo();
+            item.category = categoryFromName(category());
+            item.eventTime = eventTime();
+            item.location = location();
+            item.reportTime = reportTime();
+            item.additionalInfo = additionalInfo();
+            item.status = statusFromName(status());
+            for (size_t i = 0; i < detailCount(); i++) {
+                item.details.set(detailKey(i), detailValue(i));
+            }
+            item.text = arena;
+            return item;
+        }
+
+    private:
+        const SnapshotItemRecord* record;
+        const SnapshotDetailRecord* details;
+        const char* pool;
+        uint64_t poolSize;
+
+        std::string_view str(const SnapshotStringRef& ref) const {
+            if (static_cast<uint64_t>(ref.offset) + ref.length > poolSize) {
+                return {};  // Corrupt reference
+            }
+            return std::string_view(pool + ref.offset, ref.length);
+        }
+    };
+
+    // A snapshot file mapped read-only into memory. Pages are only faulted
+    // in when the items on them are accessed.
+    class MappedSnapshot {
+    public:
+        MappedSnapshot() = default;
+        MappedSnapshot(const MappedSnapshot&) = delete;
+        MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+        MappedSnapshot(MappedSnapshot&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        MappedSnapshot& operator=(MappedSnapshot&& other) noexcept {
+            if (this != &other) {
+                close();
+                std::swap(base, other.base);
+                std::swap(length, other.length);
+                std::swap(header, other.header);
+            }
+            return *this;
+        }
+
+        ~MappedSnapshot() {
+            close();
+        }
+
+        // Map and validate a snapshot file
+        bool open(const std::string& filename) {
+            close();
+
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return false;
+            }
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+                ::close(fd);
+                return false;
+            }
+
+            void* mapped = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapped == MAP_FAILED) {
+                return false;
+            }
+
+            base = static_cast<const char*>(mapped);
+            length = st.st_size;
+            header = reinterpret_cast<const SnapshotHeader*>(base);
+
+            if (!validate()) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close() {
+            if (base) {
+                ::munmap(const_cast<char*>(base), length);
+            }
+            base = nullptr;
+            length = 0;
+            header = nullptr;
+        }
+
+        bool isOpen() const {
+            return base != nullptr;
+        }
+
+        size_t size() const {
+            return header ? header->itemCount : 0;
+        }
+
+        // Materialize every item without copying the string pool: the items'
+        // text stays in the mapping, which moves into the arena they share
+        // and is unmapped when the last of them is gone. Leaves this
+        // snapshot closed.
+        void readItems(std::vector<Item>& items) {
+            struct MappedArena {
+                MappedSnapshot snapshot;
+                StringArena arena{0};
+            };
+            auto owner = std::make_shared<MappedArena>();
+            owner->snapshot = std::move(*this);
+            std::shared_ptr<StringArena> arena(owner, &owner->arena);
+
+            const MappedSnapshot& mapped = owner->snapshot;
+            items.reserve(items.size() + mapped.size());
+            for (size_t i = 0; i < mapped.size(); i++) {
+                items.push_back(mapped.item(i).toItem(arena));
+            }
+        }
+
+        SnapshotItemView item(size_t index) const {
+            const auto* records = reinterpret_cast<const SnapshotItemRecord*>(base + header->itemsOffset);
+            const auto* details = reinterpret_cast<const SnapshotDetailRecord*>(base + header->detailsOffset);
+            const SnapshotItemRecord* record = &records[index];
+            return SnapshotItemView(record, details + record->detailsBegin,
+                                    base + header->poolOffset, header->poolSize);
+        }
+
+    private:
+        const char* base = nullptr;
+        size_t length = 0;
+        const SnapshotHeader* header = nullptr;
+
+        // Check that every table lies inside the file; per-string bounds
+        // are checked lazily by SnapshotItemView
+        bool validate() const {
+            if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+                header->version != SNAPSHOT_VERSION) {
+                return false;
+            }
+
+            auto fits = [this](uint64_t offset, uint64_t bytes) {
+                return offset <= length && bytes <= length - offset;
+            };
+
+            if (!fits(header->itemsOffset, uint64_t(header->itemCount) * sizeof(SnapshotItemRecord)) ||
+                !fits(header->detailsOffset, header->detailCount * sizeof(SnapshotDetailRecord)) ||
+                !fits(header->poolOffset, header->poolSize)) {
+                return false;
+            }
+
+            const auto* records = reinterpret_cast<const SnapshotItemRecord*>(base + header->itemsOffset);
+            for (size_t i = 0; i < header->itemCount; i++) {
+                if (uint64_t(records[i].detailsBegin) + records[i].detailsCount > header->detailCount) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // Write items as a binary snapshot (see SnapshotHeader for the layout)
+    static bool saveBinarySnapshot(const std::string& filename, const std::vector<Item>& items) {
+        std::vector<SnapshotItemRecord> records;
+        std::vector<SnapshotDetailRecord> details;
+        std::string pool;
+        std::unordered_map<std::string_view, SnapshotStringRef> interned;  // Keys view the items
+        records.reserve(items.size());
+
+        // Deduplicate strings so repeated categories, locations, statuses
+        // and detail keys are stored once
+        auto intern = [&](std::string_view value) {
+            auto it = interned.find(value);
+            if (it != interned.end()) {
+                return it->second;
+            }
+            SnapshotStringRef ref{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(value.size())};
+            pool += value;
+            interned.emplace(value, ref);
+            return ref;
+        };
+
+        for (const auto& item : items) {
+            SnapshotItemRecord record;
+            record.id = intern(item.id);
+            record.personName = intern(item.personName);
+            record.contactInfo = intern(item.contactInfo);
+            record.category = intern(categoryName(item.category));
+            record.eventTime = intern(item.eventTime);
+            record.location = intern(item.location);
+            record.reportTime = intern(item.reportTime);
+            record.additionalInfo = intern(item.additionalInfo);
+            record.status = intern(statusNames.at(item.status));
+            record.detailsBegin = static_cast<uint32_t>(details.size());
+            record.detailsCount = static_cast<uint32_t>(item.details.size());
+            for (const auto& detail : item.details) {
+                details.push_back({intern(detail.first), intern(detail.second)});
+            }
+            records.push_back(record);
+
+            if (pool.size() > UINT32_MAX) {
+                std::cerr << "Snapshot string pool too large: " << filename << std::endl;
+                return false;
+            }
+        }
+
+        SnapshotHeader header{};
+        std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        header.version = SNAPSHOT_VERSION;
+        header.itemCount = static_cast<uint32_t>(records.size());
+        header.itemsOffset = sizeof(SnapshotHeader);
+        header.detailsOffset = header.itemsOffset + records.size() * sizeof(SnapshotItemRecord);
+        header.detailCount = details.size();
+        header.poolOffset = header.detailsOffset + details.size() * sizeof(SnapshotDetailRecord);
+        header.poolSize = pool.size();
+
+        return writeFileAtomically(filename, {
+            std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)),
+            std::string_view(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SnapshotItemRecord)),
+            std::string_view(reinterpret_cast<const char*>(details.data()), details.size() * sizeof(SnapshotDetailRecord)),
+            pool});
+    }
+
+    // Replay journal records that are not yet part of the JSON snapshots,
+    // in the order their changes were applied. A compaction interrupted by
+    // a crash leaves COMPACTING_JOURNAL_FILE behind; it is replayed first
+    // and records already present are skipped.
+    void replayJournal(ItemStore& loaded) {
+        // Items by id: list and position
+        std::unordered_map<std::string_view, std::pair<bool, size_t>> knownIds;  // Keys view the items
+        for (size_t i = 0; i < loaded.lostItems.size(); i++) {
+            knownIds.emplace(loaded.lostItems[i].id, std::make_pair(true, i));
+        }
+        for (size_t i = 0; i < loaded.foundItems.size(); i++) {
+            knownIds.emplace(loaded.foundItems[i].id, std::make_pair(false, i));
+        }
+
+        size_t replayed = 0;
+        for (const auto& filename : {COMPACTING_JOURNAL_FILE, JOURNAL_FILE}) {
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.is_open()) {
+                continue;
+            }
+
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            std::string content = buffer.str();
+
+            // Only newline-terminated records are complete; a torn tail
+            // from a crash mid-append is dropped.
+            size_t start = 0;
+            size_t end;
+            while ((end = content.find('\n', start)) != std::string::npos) {
+                std::string record = content.substr(start, end - start);
+                start = end + 1;
+
+                size_t tab = record.find('\t');
+                if (tab == std::string::npos) {
+                    continue;
+                }
+
+                std::string op = record.substr(0, tab);
+                if (op == "MATCH") {
+                    // Both halves of a match come from one record; a match
+                    // naming an unknown item is dropped whole
+                    std::string lostId;
+                    std::string foundId;
+                    JsonReader reader(std::string_view(record).substr(tab + 1));
+                    bool ok = reader.readObject([&](const std::string& key) {
+                        if (key == "lost") {
+                            return reader.readString(lostId);
+                        } else if (key == "found") {
+                            return reader.readString(foundId);
+                        }
+                        return reader.skipValue();
+                    });
+                    auto lost = knownIds.find(lostId);
+                    auto found = knownIds.find(foundId);
+                    if (ok && lost != knownIds.end() && found != knownIds.end() &&
+                        lost->second.first && !found->second.first) {
+                        loaded.lostItems[lost->second.second].status = ItemStatus::MATCHED;
+                        loaded.foundItems[found->second.second].status = ItemStatus::MATCHED;
+                        replayed++;
+                    }
+                    continue;
+                }
+
+                Item item = parseItemJson(std::string_view(record).substr(tab + 1));
+                if (item.id.empty()) {
+                    continue;
+                }
+
+                if (op == "STATUS") {
+                    // Status changes are idempotent, so replaying one that
+                    // is already in the snapshot is harmless
+                    auto it = knownIds.find(item.id);
+                    if (it != knownIds.end()) {
+                        auto& items = it->second.first ? loaded.lostItems : loaded.foundItems;
+                        items[it->second.second].status = item.status;
+                        replayed++;
+                    }
+                    continue;
+                }
+
+                if (op != "LOST" && op != "FOUND") {
+                    continue;
+                }
+                auto& items = (op == "LOST") ? loaded.lostItems : loaded.foundItems;
+                if (!knownIds.emplace(item.id, std::make_pair(op == "LOST", items.size())).second) {
+                    continue;
+                }
+                items.push_back(item);
+                replayed++;
+            }
+        }
+
+        journalRecordCount = replayed;
+    }
+
+    // Open the journal for appending and start the background worker
+    void openJournal() {
+        journalFd = ::open(JOURNAL_FILE.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (journalFd < 0) {
+            std::cerr << "Failed to open journal: " << JOURNAL_FILE << std::endl;
+            return;
+        }
+
+        journalWorker = std::thread(&LostFoundBot::runJournalWorker, this);
+    }
+
+    // Flush outstanding records, stop the worker and close the journal
+    void closeJournal() {
+        {
+            std::lock_guard<std::mutex> lock(journalMutex);
+            journalStopping = true;
+        }
+        journalCv.notify_all();
+
+        if (journalWorker.joinable()) {
+            journalWorker.join();
+        }
+
+        if (journalFd >= 0) {
+            syncJournal();
+            ::close(journalFd);
+            journalFd = -1;
+        }
+    }
+
+    // fsync the journal (caller holds journalMutex and no group fsync is
+    // running, or owns the fd exclusively)
+    void syncJournal() {
+        if (journalSyncedSeq < journalWrittenSeq && journalFd >= 0) {
+            ::fdatasync(journalFd);
+        }
+        journalSyncedSeq = journalWrittenSeq;
+    }
+
+    // Journal record for a new item: LOST|FOUND\t<item json>
+    static std::string itemRecord(bool isLost, const Item& item) {
+        return std::string(isLost ? "LOST" : "FOUND") + "\t" + itemToJson(item) + "\n";
+    }
+
+    // Journal record for a status change: STATUS\t{"id":"...","status":"..."}
+    static std::string statusRecord(const std::string& id, ItemStatus status) {
+        return "STATUS\t{\"id\":\"" + escapeJsonString(id) + "\",\"status\":\"" +
+               statusNames.at(status) + "\"}\n";
+    }
+
+    // Journal record for a match: MATCH\t{"lost":"...","found":"..."}.
+    // One record covers both items, so a crash can never replay half a match.
+    static std::string matchRecord(const std::string& lostId, const std::string& foundId) {
+        return "MATCH\t{\"lost\":\"" + escapeJsonString(lostId) + "\",\"found\":\"" +
+               escapeJsonString(foundId) + "\"}\n";
+    }
+
+    // Journal a change and apply it in one journalMutex critical section,
+    // so records reach the journal in exactly the order their changes were
+    // applied and a rotation never falls between the two. prepare checks
+    // the change against the store and returns its record, or "" to refuse
+    // it; apply makes the change with store.write once the record is
+    // written. Only journalMutex holders write the store, so the check
+    // still holds by then. Returns false, with nothing applied, if the
+    // record could not be written. Otherwise returns once the record is
+    // durable: writers group-commit, the first to need an fsync runs it for
+    // every record written so far and writers arriving meanwhile wait for
+    // that fsync or the next.
+    template <typename Prepare, typename Apply>
+    bool commitMutation(Prepare&& prepare, Apply&& apply) {
+        journalAppenders++;
+        std::unique_lock<std::mutex> lock(journalMutex);
+        std::string record = prepare();
+        bool ok = record.empty() || appendJournalLocked(record, apply, lock);
+        journalAppenders--;
+        return ok;
+    }
+
+    template <typename Apply>
+    bool appendJournalLocked(const std::string& record, Apply& apply, std::unique_lock<std::mutex>& lock) {
+        if (journalFd < 0) {
+            // Journal unavailable; apply the change and fall back to a full
+            // snapshot rewrite, whose copy then covers it
+            apply();
+            lock.unlock();
+            bool ok = saveItems();
+            lock.lock();
+            return ok;
+        }
+
+        // On a failed write, cut the journal back to where the record
+        // started so a torn record never glues onto the next one, and
+        // leave the store untouched
+        const off_t start = ::lseek(journalFd, 0, SEEK_END);
+        const char* data = record.data();
+        size_t remaining = record.size();
+        while (remaining > 0) {
+            ssize_t written = ::write(journalFd, data, remaining);
+            if (written <= 0) {
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Failed to write journal record: " << std::strerror(errno) << std::endl;
+                if (start < 0 || ::ftruncate(journalFd, start) != 0) {
+                    std::cerr << "Failed to trim the journal after a failed write" << std::endl;
+                }
+                return false;
+            }
+            data += written;
+            remaining -= written;
+        }
+
+        apply();
+        journalRecordCount += std::count(record.begin(), record.end(), '\n');
+        const uint64_t seq = ++journalWrittenSeq;
+
+        while (journalSyncedSeq < seq) {
+            if (journalSyncing) {
+                journalCv.wait(lock);
+                continue;
+            }
+
+            // Lead a group fsync. With other writers in flight, give them
+            // a moment to add their records to it first.
+            journalSyncing = true;
+            if (journalAppenders.load() > 1) {
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::microseconds(JOURNAL_GROUP_COMMIT_US));
+                lock.lock();
+            }
+            const uint64_t target = journalWrittenSeq;
+            const int fd = journalFd;
+            lock.unlock();
+            ::fdatasync(fd);
+            lock.lock();
+            journalSyncedSeq = std::max(journalSyncedSeq, target);
+            journalSyncing = false;
+            journalCv.notify_all();
+        }
+
+        if (journalRecordCount >= JOURNAL_COMPACT_THRESHOLD) {
+            rotateJournal(lock);
+        }
+        return true;
+    }
+
+    // Wait out a running group fsync before the journal fd is closed or
+    // truncated (caller holds journalMutex)
+    void waitForJournalSync(std::unique_lock<std::mutex>& lock) {
+        journalCv.wait(lock, [this] { return !journalSyncing; });
+    }
+
+    // Rotate the journal and wake the worker, which copies the item lists
+    // out of the store and writes them as the new snapshots (caller holds
+    // journalMutex). Every record in the rotated journal was applied to the
+    // store before journalMutex was released, so the worker's copy covers
+    // it. Returns
+    // false if no compaction was started.
+    bool rotateJournal(std::unique_lock<std::mutex>& lock) {
+        if (journalFd < 0 || compactionPending || std::filesystem::exists(COMPACTING_JOURNAL_FILE)) {
+            return false;  // No journal, or a previous compaction still running
+        }
+
+        waitForJournalSync(lock);
+        if (compactionPending) {
+            return false;  // Another writer rotated while this one waited
+        }
+        syncJournal();
+        ::close(journalFd);
+
+        std::error_code ec;
+        std::filesystem::rename(JOURNAL_FILE, COMPACTING_JOURNAL_FILE, ec);
+        journalFd = ::open(JOURNAL_FILE.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (ec) {
+            std::cerr << "Failed to rotate journal: " << ec.message() << std::endl;
+            return false;
+        }
+
+        compactionPending = true;
+        journalRecordCount = 0;
+        journalCv.notify_all();
+        return true;
+    }
+
+    // Background worker: compaction
+    void runJournalWorker() {
+        std::unique_lock<std::mutex> lock(journalMutex);
+
+        while (true) {
+            journalCv.wait(lock, [this] {
+                return journalStopping || compactionPending;
+            });
+
+            if (compactionPending) {
+                // Copy and write without holding the lock so appends continue
+                // (a failed write keeps the rotated journal for the next start)
+                lock.unlock();
+                if (writeSnapshots()) {
+                    std::error_code ec;
+                    std::filesystem::remove(COMPACTING_JOURNAL_FILE, ec);
+                }
+                lock.lock();
+
+                compactionPending = false;
+                journalCv.notify_all();
+            }
+
+            if (journalStopping) {
+                break;
+            }
+        }
+    }
+
+    // Items copied per read when taking a snapshot, so no read lasts long
+    static constexpr size_t SNAPSHOT_CHUNK = 4096;
+
+    // Copy one item list out of the store in short reads. Slots only grow,
+    // so the copy has every item added before the call; an item whose
+    // status changes meanwhile may show either status, and the journal
+    // records the change either way.
+    std::vector<Item> copyItems(bool isLost) const {
+        return copyItems(isLost, [](const Item&) { return true; });
+    }
+
+    // Copy the items of one list that keep(item) accepts
+    template <typename Keep>
+    std::vector<Item> copyItems(bool isLost, Keep&& keep) const {
+        std::vector<Item> items;
+        size_t copied = 0;
+        bool more = true;
+        while (more) {
+            store.read([&](const ItemStore& current) {
+                const std::vector<Item>& list = current.items(isLost);
+                const size_t end = std::min(list.size(), copied + SNAPSHOT_CHUNK);
+                for (; copied < end; copied++) {
+                    if (keep(list[copied])) {
+                        items.push_back(list[copied]);
+                    }
+                }
+                more = end < list.size();
+            });
+        }
+        return items;
+    }
+
+    // Write both item lists out as the JSON (and binary) snapshots.
+    // Returns false if any write failed.
+    bool writeSnapshots() {
+        bool ok = true;
+        for (bool isLost : {true, false}) {
+            std::vector<Item> items = copyItems(isLost);
+            ok = saveItemsToFile(isLost ? LOST_ITEMS_FILE : FOUND_ITEMS_FILE, items) && ok;
+            if (BINARY_SNAPSHOTS_ENABLED) {
+                ok = saveBinarySnapshot(isLost ? LOST_SNAPSHOT_FILE : FOUND_SNAPSHOT_FILE, items) && ok;
+            }
+        }
+        return ok;
+    }
+
+    // Write both item lists out as fresh snapshots and retire the journal.
+    // Used after bulk changes, where one rewrite beats a record per item.
+    // The write runs as a compaction, so reports keep flowing meanwhile.
+    void checkpoint() {
+        std::unique_lock<std::mutex> lock(journalMutex);
+
+        // A running compaction may have copied the lists before the bulk
+        // change; let it finish, then start one that copies after it
+        journalCv.wait(lock, [this] { return !compactionPending; });
+        if (!rotateJournal(lock)) {
+            // Nothing to rotate into (no journal, or a rotated journal left
+            // by a failed compaction); write the snapshots directly. The
+            // journals stay and replay on top of them harmlessly.
+            lock.unlock();
+            writeSnapshots();
+            return;
+        }
+        journalCv.wait(lock, [this] { return !compactionPending; });
+    }
+
+    // Add a new item to the store and journal it. A found item is then
+    // run against the standing queries, and the lost reports it matched
+    // go to notified. Returns false if the item could not be saved.
+    bool storeItem(bool isLost, const Item& item, std::vector<std::pair<Item, int>>* notified = nullptr) {
+        bool ok = commitMutation(
+            [&] { return itemRecord(isLost, item); },
+            [&] {
+                store.write([&](ItemStore& current) {
+                    current.addItem(isLost, item);
+                });
+            });
+        if (!ok) {
+            return false;
+        }
+        if (!isLost) {
+            std::vector<std::pair<Item, int>> matches = notifyStandingQueries(item.id);
+            if (notified) {
+                *notified = std::move(matches);
+            }
+        }
+        return true;
+    }
+
+    // Match a stored found item against the open lost reports' standing
+    // queries and tell every subscriber about each match, best first
+    std::vector<std::pair<Item, int>> notifyStandingQueries(std::string_view foundId) {
+        std::vector<std::pair<Item, int>> matches;
+        Item found;
+        store.read([&](const ItemStore& current) {
+            const Item* item = current.findItem(foundId);
+            if (!item) {
+                return;
+            }
+            found = *item;
+            for (const auto& match : current.percolate(*item, STANDING_MATCH_MIN_SCORE)) {
+                matches.emplace_back(current.lostItems[match.first], match.second);
+            }
+        });
+
+        // Callbacks run outside the read, so they may use the bot freely
+        std::vector<MatchCallback> callbacks;
+        if (!matches.empty()) {
+            std::lock_guard<std::mutex> lock(subscribersMutex);
+            callbacks = subscribers;
+        }
+        for (const auto& match : matches) {
+            for (const auto& callback : callbacks) {
+                callback(match.first, found, match.second);
+            }
+        }
+        return matches;
+    }
+
+    // Why a status change was refused
+    enum class ResolveError { NONE, NOT_FOUND, WRONG_TYPE, NOT_OPEN, NOT_SAVED };
+
+    // Move an open item to a new status and journal the change. With
+    // foundOnly set, the id must be a found item (a claim).
+    ResolveError resolveItem(const std::string& id, ItemStatus status, bool foundOnly) {
+        ResolveError error = ResolveError::NONE;
+        bool ok = commitMutation(
+            [&] {
+                store.read([&](const ItemStore& current) {
+                    error = checkOpen(current, id, foundOnly ? 0 : -1);
+                });
+                return error == ResolveError::NONE ? statusRecord(id, status) : std::string();
+            },
+            [&] {
+                store.write([&](ItemStore& current) {
+                    current.setStatus(id, status);
+                });
+            });
+        return ok ? error : ResolveError::NOT_SAVED;
+    }
+
+    // Mark an open lost item and an open found item as matched to each other
+    ResolveError matchItems(const std::string& lostId, const std::string& foundId) {
+        ResolveError error = ResolveError::NONE;
+        bool ok = commitMutation(
+            [&] {
+                store.read([&](const ItemStore& current) {
+                    error = checkOpen(current, lostId, 1);
+                    if (error == ResolveError::NONE) {
+                        error = checkOpen(current, foundId, 0);
+                    }
+                });
+                return error == ResolveError::NONE ? matchRecord(lostId, foundId) : std::string();
+            },
+            [&] {
+                store.write([&](ItemStore& current) {
+                    current.setStatus(lostId, ItemStatus::MATCHED);
+                    current.setStatus(foundId, ItemStatus::MATCHED);
+                });
+            });
+        return ok ? error : ResolveError::NOT_SAVED;
+    }
+
+    // Check an id names an open item; wantLost is 1 (lost), 0 (found) or
+    // -1 (either). Archived items are read-only, so they are not found.
+    static ResolveError checkOpen(const ItemStore& current, const std::string& id, int wantLost) {
+        auto it = current.idSlots.find(id);
+        if (it == current.idSlots.end()) {
+            return ResolveError::NOT_FOUND;
+        }
+        if (wantLost >= 0 && it->second.isLost != (wantLost == 1)) {
+            return ResolveError::WRONG_TYPE;
+        }
+        const Item& item = current.items(it->second.isLost)[it->second.slot];
+        return item.status == ItemStatus::OPEN ? ResolveError::NONE : ResolveError::NOT_OPEN;
+    }
+
+    static const char* resolveErrorText(ResolveError error) {
+        switch (error) {
+            case ResolveError::NOT_FOUND: return "no open item with that id";
+            case ResolveError::WRONG_TYPE: return "item is not of the expected type";
+            case ResolveError::NOT_OPEN: return "item is already resolved";
+            case ResolveError::NOT_SAVED: return "the change could not be saved";
+            default: return "";
+        }
+    }
+
+    // Save a lost item; returns false if it could not be saved
+    bool saveLostItem(
+        const std::string& reporterName,
+        const std::string& contactInfo,
+        ItemCategory category,
+        const std::string& lostTime,
+        const std::string& location,
+        const std::map<std::string, std::string>& itemDetails,
+        const std::string& additionalDetails
+    ) {
+        Item item;
+        item.set(&Item::id, generateId());
+        item.set(&Item::personName, reporterName);
+        item.set(&Item::contactInfo, contactInfo);
+        item.category = category;
+        item.set(&Item::eventTime, lostTime);
+        item.set(&Item::location, location);
+        for (const auto& detail : itemDetails) {
+            item.setDetail(detail.first, detail.second);
+        }
+        item.set(&Item::additionalInfo, additionalDetails);
+        item.set(&Item::reportTime, getCurrentTimestamp());
+        item.status = ItemStatus::OPEN;
+
+        return storeItem(true, std::move(item));
+    }
+
+    // Save a found item; the lost reports it matched go to notified.
+    // Returns false if it could not be saved.
+    bool saveFoundItem(
+        const std::string& finderName,
+        const std::string& contactInfo,
+        ItemCategory category,
+        const std::string& foundTime,
+        const std::string& location,
+        const std::map<std::string, std::string>& itemDetails,
+        const std::string& additionalDetails,
+        std::vector<std::pair<Item, int>>& notified
+    ) {
+        Item item;
+        item.set(&Item::id, generateId());
+        item.set(&Item::personName, finderName);
+        item.set(&Item::contactInfo, contactInfo);
+        item.category = category;
+        item.set(&Item::eventTime, foundTime);
+        item.set(&Item::location, location);
+        for (const auto& detail : itemDetails) {
+            item.setDetail(detail.first, detail.second);
+        }
+        item.set(&Item::additionalInfo, additionalDetails);
+        item.set(&Item::reportTime, getCurrentTimestamp());
+        item.status = ItemStatus::OPEN;
+
+        return storeItem(false, std::move(item), &notified);
+    }
+
+    // Lowest fuzzy similarity (0-9) that still scores
+    static constexpr int FUZZY_MIN_SCORE = 5;
+
+    // Most points the free-text (BM25) term adds to a match score
+    static constexpr int TEXT_SCORE_MAX = 20;
+
+    // Score one attribute or location value pair: 10 for an exact match;
+    // otherwise the trigram similarity (Dice coefficient) scaled to 0-9,
+    // with at least 5 when one value's trigrams are all in the other.
+    // Interned values compare by symbol, so the signatures are only looked
+    // at when the symbols differ.
+    static int valueScore(uint32_t symbol1, const TrigramSignature& signature1,
+                          uint32_t symbol2, const TrigramSignature& signature2) {
+        if (signature1.count == 0 || signature2.count == 0) {
+            return 0;  // Blank answers say nothing about a match
+        }
+        if (symbol1 == symbol2 && symbol1 != SymbolTable::NO_SYMBOL) {
+            return 10;  // Exact match
+        }
+
+        const int shared = static_cast<int>((signature1.bits & signature2.bits).count());
+        const int similarity = std::min(9, 20 * shared / (signature1.count + signature2.count));
+        if (shared == std::min(signature1.count, signature2.count)) {
+            return std::max(5, similarity);  // Partial match
+        }
+        return similarity >= FUZZY_MIN_SCORE ? similarity : 0;
+    }
+
+    // Sorted, distinct character trigrams of a value. Runs of characters
+    // other than letters and digits become one space, and the value is
+    // padded with a space on each side, so word starts and ends count.
+    // Each trigram is packed into the low 24 bits.
+    static std::vector<uint32_t> valueTrigrams(std::string_view value) {
+        std::string padded = " ";
+        for (char c : value) {
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                padded += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            } else if (padded.back() != ' ') {
+                padded += ' ';
+            }
+        }
+        if (padded.back() != ' ') {
+            padded += ' ';
+        }
+
+        std::vector<uint32_t> trigrams;
+        for (size_t i = 0; i + 3 <= padded.size(); i++) {
+            trigrams.push_back(static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16 |
+                               static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                               static_cast<unsigned char>(padded[i + 2]));
+        }
+
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        return trigrams;
+    }
+
+    // Signature of a value: its trigrams hashed into 256 bits
+    static TrigramSignature trigramSignature(std::string_view value) {
+        TrigramSignature signature;
+        for (uint32_t trigram : valueTrigrams(value)) {
+            signature.bits.set((trigram * 0x9E3779B1u) >> 24);
+        }
+        signature.count = static_cast<uint16_t>(signature.bits.count());
+        return signature;
+    }
+
+    // The free text of an item that goes into the text index
+    static std::string itemText(const Item& item) {
+        std::string text(item.additionalInfo);
+        auto features = item.details.find("distinguishing_features");
+        if (features != item.details.end()) {
+            text += " ";
+            text += features->second;
+        }
+        return text;
+    }
+
+    // Split free text into lowercase words of letters and digits
+    static std::vector<std::string> tokenizeText(std::string_view text) {
+        std::vector<std::string> words;
+        std::string current;
+
+        for (char c : text) {
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                current += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            } else if (!current.empty()) {
+                words.push_back(current);
+                current.clear();
+            }
+        }
+        if (!current.empty()) {
+            words.push_back(current);
+        }
+
+        return words;
+    }
+
+    // Distinct words of a free-text query
+    static std::vector<std::string> textTerms(std::string_view text) {
+        std::vector<std::string> words = tokenizeText(text);
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        return words;
+    }
+
+    // LEB128-style varints for the text posting lists
+    static void appendVarint(std::vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint32_t readVarint(const uint8_t*& cursor) {
+        uint32_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t byte = *cursor++;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+    // Index key for an (attribute, trigram) pair
+    static uint32_t indexKey(uint8_t attribute, uint32_t trigram) {
+        return static_cast<uint32_t>(attribute) << 24 | trigram;
+    }
+
+    // Runs batches of tasks on a fixed set of threads, started by the
+    // first batch and kept for the next. Each worker owns a deque: it pops
+    // its own tasks from the back and, when empty, steals from the front
+    // of the others. One batch runs at a time; the caller is worker 0.
+    class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(size_t threadCount)
+            : queues(threadCount > 0 ? threadCount : 1) {}
+
+        ~WorkStealingPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        size_t threadCount() const {
+            return queues.size();
+        }
+
+        // Execute task(taskIndex, workerIndex) for every task index and
+        // return once all are done
+        template <typename Task>
+        void run(size_t taskCount, Task&& task) {
+            std::lock_guard<std::mutex> batchLock(batchMutex);
+            for (size_t i = 0; i < taskCount; i++) {
+                queues[i % queues.size()].tasks.push_back(i);
+            }
+
+            const std::function<void(size_t, size_t)> batch = std::ref(task);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t worker = threads.size() + 1; worker < queues.size(); worker++) {
+                    threads.emplace_back(&WorkStealingPool::workerLoop, this, worker);
+                }
+                current = &batch;
+                busy = queues.size() - 1;
+                generation++;
+            }
+            wake.notify_all();
+            work(0, batch);
+
+            // The other workers may still be on their last task
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return busy == 0; });
+            current = nullptr;
+        }
+
+    private:
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+
+        std::vector<WorkQueue> queues;
+        std::vector<std::thread> threads;
+        std::mutex batchMutex;  // One batch at a time
+        std::mutex mutex;       // Guards the batch hand-off below
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(size_t, size_t)>* current = nullptr;
+        uint64_t generation = 0;
+        size_t busy = 0;
+        bool stopping = false;
+
+        // Pool thread: wait for a batch, help run it, report back
+        void workerLoop(size_t worker) {
+            uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                const std::function<void(size_t, size_t)>* task = current;
+                lock.unlock();
+                work(worker, *task);
+                lock.lock();
+                if (--busy == 0) {
+                    done.notify_all();
+                }
+            }
+        }
+
+        void work(size_t worker, const std::function<void(size_t, size_t)>& task) {
+            size_t taskIndex;
+            while (popLocal(worker, taskIndex) || steal(worker, taskIndex)) {
+                task(taskIndex, worker);
+            }
+        }
+
+        bool popLocal(size_t worker, size_t& taskIndex) {
+            std::lock_guard<std::mutex> lock(queues[worker].mutex);
+            if (queues[worker].tasks.empty()) {
+                return false;
+            }
+            taskIndex = queues[worker].tasks.back();
+            queues[worker].tasks.pop_back();
+            return true;
+        }
+
+        bool steal(size_t thief, size_t& taskIndex) {
+            for (size_t offset = 1; offset < queues.size(); offset++) {
+                WorkQueue& victim = queues[(thief + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    taskIndex = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    // Bulk matching runs share one pool, so repeated runs reuse its threads
+    // (and their metrics shards) instead of starting new ones
+    WorkStealingPool matchPool{std::max(1u, std::thread::hardware_concurrency())};
+
+    // Results shown per page in the interactive search
+    static constexpr size_t SEARCH_PAGE_SIZE = 5;
+
+    // Largest page size and offset a search request may ask for
+    static constexpr long long MAX_SEARCH_LIMIT = 1000;
+    static constexpr long long MAX_SEARCH_OFFSET = 100000;
+
+    // Bounded min-heap keeping the best `capacity` results seen so far.
+    // Ties prefer the lower slot (the earlier report).
+    class TopKCollector {
+    public:
+        // expected bounds the up-front allocation (the number of items that
+        // can be offered), so a huge page size costs nothing extra
+        TopKCollector(size_t capacity, size_t expected) : capacity(capacity) {
+            heap.reserve(std::min(capacity, expected));
+        }
+
+        void offer(uint32_t slot, int score) {
+            if (capacity == 0) {
+                return;
+            }
+            SearchResult result{slot, score};
+            if (heap.size() < capacity) {
+                heap.push_back(result);
+                std::push_heap(heap.begin(), heap.end(), better);
+            } else if (better(result, heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = result;
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+
+        // Results best-first; the collector is left empty
+        std::vector<SearchResult> takeSorted() {
+            std::sort_heap(heap.begin(), heap.end(), better);
+            return std::move(heap);
+        }
+
+    private:
+        size_t capacity;
+        std::vector<SearchResult> heap;  // heap.front() is the worst kept result
+
+        static bool better(const SearchResult& a, const SearchResult& b) {
+            return a.score != b.score ? a.score > b.score : a.slot < b.slot;
+        }
+    };
+
+    // One row of the bulk match table
+    struct MatchPair {
+        uint32_t lostSlot;
+        uint32_t foundSlot;
+        int score;
+    };
+
+    // Lost items per bulk matching task
+    static constexpr size_t BULK_MATCH_CHUNK = 256;
+
+    // Compute the best found candidates for every OPEN lost item, using all
+    // cores. Work is partitioned by category and split into chunks that
+    // idle workers steal. Returns pairs ranked by score (highest first).
+    // Every read is short (one chunk of the scan, one lost item's search),
+    // so a long run never holds up writers.
+    std::vector<MatchPair> runBulkMatching(int minScore, size_t candidatesPerItem) {
+        Metrics::Timer timer(Metrics::REMATCH);
+
+        // Partition OPEN lost items by category. Slots only grow, so they
+        // stay valid after the read that found them.
+        std::map<ItemCategory, std::vector<uint32_t>> partitions;
+        size_t scanned = 0;
+        bool more = true;
+        while (more) {
+            store.read([&](const ItemStore& current) {
+                const size_t end = std::min(current.lostItems.size(), scanned + SNAPSHOT_CHUNK);
+                for (; scanned < end; scanned++) {
+                    if (current.lostItems[scanned].status == ItemStatus::OPEN) {
+                        partitions[current.lostItems[scanned].category].push_back(static_cast<uint32_t>(scanned));
+                    }
+                }
+                more = end < current.lostItems.size();
+            });
+        }
+
+        // Split each partition into chunks
+        struct Task {
+            const std::vector<uint32_t>* slots;
+            size_t begin;
+            size_t end;
+        };
+        std::vector<Task> tasks;
+        for (const auto& partition : partitions) {
+            for (size_t begin = 0; begin < partition.second.size(); begin += BULK_MATCH_CHUNK) {
+                tasks.push_back({&partition.second, begin,
+                                 std::min(begin + BULK_MATCH_CHUNK, partition.second.size())});
+            }
+        }
+
+        std::vector<std::vector<MatchPair>> results(matchPool.threadCount());
+
+        matchPool.run(tasks.size(), [&](size_t taskIndex, size_t worker) {
+            const Task& task = tasks[taskIndex];
+
+            for (size_t i = task.begin; i < task.end; i++) {
+                uint32_t lostSlot = (*task.slots)[i];
+                store.read([&](const ItemStore& current) {
+                    const Item& lost = current.lostItems[lostSlot];
+                    if (lost.status != ItemStatus::OPEN) {
+                        return;  // Resolved since the scan
+                    }
+                    MatchQuery query = current.queryFromItem(lost);
+
+                    // Keep only the best few candidates per lost item
+                    SearchOptions options;
+                    options.limit = candidatesPerItem;
+                    options.minScore = minScore;
+                    for (const SearchResult& result : current.findMatches(true, query, options)) {
+                        results[worker].push_back({lostSlot, result.slot, result.score});
+                    }
+                });
+            }
+        });
+
+        std::vector<MatchPair> table;
+        for (auto& workerResults : results) {
+            table.insert(table.end(), workerResults.begin(), workerResults.end());
+        }
+        std::sort(table.begin(), table.end(), [](const MatchPair& a, const MatchPair& b) {
+            if (a.score != b.score) {
+                return a.score > b.score;
+            }
+            return a.lostSlot != b.lostSlot ? a.lostSlot < b.lostSlot : a.foundSlot < b.foundSlot;
+        });
+        return table;
+    }
+
+    // Write the match table as CSV for staff
+    void saveMatchTable(const std::string& filename, const std::vector<MatchPair>& table) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return;
+        }
+
+        file << "rank,score,category,lost_id,found_id,lost_location,found_location\n";
+        // Format a chunk of rows per read and write it out after the read
+        for (size_t begin = 0; begin < table.size(); begin += SNAPSHOT_CHUNK) {
+            const size_t end = std::min(table.size(), begin + SNAPSHOT_CHUNK);
+            std::ostringstream rows;
+            store.read([&](const ItemStore& current) {
+                for (size_t i = begin; i < end; i++) {
+                    const Item& lost = current.lostItems[table[i].lostSlot];
+                    const Item& found = current.foundItems[table[i].foundSlot];
+                    rows << (i + 1) << "," << table[i].score << "," << categoryName(lost.category) << ","
+                         << lost.id << "," << found.id << ","
+                         << csvField(lost.location) << "," << csvField(found.location) << "\n";
+                }
+            });
+            file << rows.str();
+        }
+    }
+
+    // Quote a CSV field
+    static std::string csvField(std::string_view value) {
+        std::string quoted = "\"";
+        for (char c : value) {
+            if (c == '"') {
+                quoted += '"';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    // Run a search and copy out the items on the requested page, so they
+    // can be shown after the read has ended
+    std::vector<std::pair<Item, int>> fetchMatchPage(bool isLostItem, const MatchQuery& query,
+                                                     const SearchOptions& options, size_t* totalMatches = nullptr) {
+        return store.read([&](const ItemStore& current) {
+            std::vector<std::pair<Item, int>> page;
+            for (const SearchResult& result : current.findMatches(isLostItem, query, options, totalMatches)) {
+                page.emplace_back(current.items(!isLostItem)[result.slot], result.score);
+            }
+            return page;
+        });
+    }
+
+    // Search for matching items and page through them interactively
+    void searchForMatches(bool isLostItem, ItemCategory category, const std::map<std::string, std::string>& searchDetails,
+                          const std::string& text = "", const std::string& eventTime = "") {
+        // Normalize the search once up front
+        MatchQuery query = store.read([&](const ItemStore& current) {
+            return current.buildQuery(category, searchDetails, "", text, eventTime);
+        });
+
+        SearchOptions options;
+        options.limit = SEARCH_PAGE_SIZE;
+        size_t totalMatches = 0;
+        std::vector<std::pair<Item, int>> page = fetchMatchPage(isLostItem, query, options, &totalMatches);
+
+        // Display matches
+        std::cout << "\nPotential matches found: " << totalMatches << std::endl;
+
+        for (size_t i = 0; i < totalMatches; i++) {
+            // Fetch the next page once this one is used up
+            if (i - options.offset >= page.size()) {
+                options.offset = i;
+                page = fetchMatchPage(isLostItem, query, options);
+                if (page.empty()) {
+                    break;
+                }
+            }
+
+            const Item& match = page[i - options.offset].first;
+            std::cout << "\nMatch #" << (i + 1) << " (Score: " << page[i - options.offset].second << "):" << std::endl;
+            std::cout << "Category: " << categoryName(match.category) << std::endl;
+            std::cout << "Location: " << match.location << std::endl;
+            std::cout << (isLostItem ? "Found" : "Lost") << " Time: " << match.eventTime << std::endl;
+
+            std::cout << "Details:" << std::endl;
+            for (const auto& detail : match.details) {
+                std::string displayName(detail.first);
+                std::replace(displayName.begin(), displayName.end(), '_', ' ');
+                if (!displayName.empty()) {
+                    displayName[0] = std::toupper(displayName[0]);
+                }
+                std::cout << "  " << displayName << ": " << detail.second << std::endl;
+            }
+
+            std::cout << "Additional Info: " << match.additionalInfo << std::endl;
+
+            // Ask if user wants to contact the person
+            if (i < totalMatches - 1) {
+                std::cout << "\nPress Enter to see next match or 'C' to contact this person: ";
+            } else {
+                std::cout << "\nPress 'C' to contact this person or any other key to return: ";
+            }
+
+            std::string response;
+            std::getline(std::cin, response);
+
+            if (response == "C" || response == "c") {
+                std::cout << "\nContact Information:" << std::endl;
+                std::cout << "Name: " << match.personName << std::endl;
+                std::cout << "Contact: " << match.contactInfo << std::endl;
+
+                std::cout << "\nPress Enter to continue...";
+                std::getline(std::cin, response);
+                break;
+            }
+        }
+
+        if (totalMatches == 0) {
+            std::cout << "No potential matches found." << std::endl;
+        }
+    }
+
+    // Parse CSV text into rows of fields (RFC 4180 quoting, quoted fields
+    // may span lines)
+    static std::vector<std::vector<std::string>> parseCsv(std::string_view text) {
+        std::vector<std::vector<std::string>> rows;
+        std::vector<std::string> row;
+        std::string field;
+        bool inQuotes = false;
+        bool rowHasData = false;
+
+        for (size_t i = 0; i < text.size(); i++) {
+            char c = text[i];
+            if (inQuotes) {
+                if (c == '"') {
+                    if (i + 1 < text.size() && text[i + 1] == '"') {
+                        field += '"';
+                        i++;
+                    } else {
+                        inQuotes = false;
+                    }
+                } else {
+                    field += c;
+                }
+            } else if (c == '"') {
+                inQuotes = true;
+                rowHasData = true;
+            } else if (c == ',') {
+                row.push_back(std::move(field));
+                field.clear();
+                rowHasData = true;
+            } else if (c == '\n' || c == '\r') {
+                if (c == '\r' && i + 1 < text.size() && text[i + 1] == '\n') {
+                    i++;
+                }
+                if (rowHasData || !field.empty()) {
+                    row.push_back(std::move(field));
+                    rows.push_back(std::move(row));
+                }
+                row.clear();
+                field.clear();
+                rowHasData = false;
+            } else {
+                field += c;
+            }
+        }
+
+        if (rowHasData || !field.empty()) {
+            row.push_back(std::move(field));
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+    // One record of an ingest batch
+    struct BatchRecord {
+        bool isLost = true;
+        Item item;
+    };
+
+    // Fill in and validate a batch record; returns an error message or ""
+    std::string completeBatchRecord(BatchRecord& record, const std::string& type,
+                                    const std::string& categoryName) {
+        if (type == "lost") {
+            record.isLost = true;
+        } else if (type == "found") {
+            record.isLost = false;
+        } else {
+            return "type must be \"lost\" or \"found\"";
+        }
+
+        if (!findCategory(categoryName, record.item.category)) {
+            return "unknown category \"" + categoryName + "\"";
+        }
+
+        if (!isValidDateTime(record.item.eventTime)) {
+            return "eventTime must be YYYY-MM-DD HH:MM";
+        }
+
+        // Historical imports keep their ids and timestamps
+        if (record.item.id.empty()) {
+            record.item.set(&Item::id, generateId());
+        }
+        if (record.item.reportTime.empty()) {
+            record.item.set(&Item::reportTime, getCurrentTimestamp());
+        }
+        return "";
+    }
+
+    // Parse one NDJSON ingest line; defaultType applies when the record
+    // has no "type" member
+    std::string parseNdjsonRecord(std::string_view line, BatchRecord& record,
+                                  const std::string& defaultType = "") {
+        JsonReader reader(line);
+        std::string type = defaultType;
+        std::string categoryName;
+
+        bool ok = reader.readObject([&](const std::string& key) {
+            if (key == "type") {
+                return reader.readString(type);
+            } else if (key == "category") {
+                return reader.readString(categoryName);
+            }
+            return parseItemMember(reader, record.item, key, record.item.writableText());
+        });
+
+        if (!ok || !reader.atEnd()) {
+            return "malformed JSON near offset " + std::to_string(reader.position());
+        }
+        return completeBatchRecord(record, type, categoryName);
+    }
+
+    // Parse one CSV ingest row; columns not naming an item field are details
+    std::string parseCsvRecord(const std::vector<std::string>& header, const std::vector<std::string>& row,
+                               BatchRecord& record) {
+        if (row.size() != header.size()) {
+            return "expected " + std::to_string(header.size()) + " fields, got " + std::to_string(row.size());
+        }
+
+        std::string type;
+        std::string categoryName;
+        for (size_t i = 0; i < header.size(); i++) {
+            const std::string& column = header[i];
+            if (column == "type") {
+                type = row[i];
+            } else if (column == "category") {
+                categoryName = row[i];
+            } else if (column == "status") {
+                record.item.status = statusFromName(row[i]);
+            } else if (auto field = itemField(column)) {
+                record.item.set(field, row[i]);
+            } else if (!row[i].empty()) {
+                record.item.setDetail(column, row[i]);
+            }
+        }
+        return completeBatchRecord(record, type, categoryName);
+    }
+
+    // Add parsed batch records to the store as one journaled mutation:
+    // their records go out in a single write and the batch is published to
+    // readers in one store.write. Records whose id is already stored, or
+    // repeated within the batch, are skipped; the check runs under
+    // journalMutex, so a report arriving meanwhile cannot slip in between.
+    // Returns false, with nothing added, if the batch could not be saved.
+    bool applyBatch(const std::vector<BatchRecord>& records, size_t& added, size_t& duplicates) {
+        std::vector<const BatchRecord*> fresh;
+        bool ok = commitMutation(
+            [&] {
+                fresh.clear();
+                duplicates = 0;
+                std::unordered_set<std::string_view> batchIds;
+                store.read([&](const ItemStore& current) {
+                    for (const auto& record : records) {
+                        if (current.idSlots.count(record.item.id) ||
+                            !batchIds.emplace(record.item.id).second) {
+                            duplicates++;
+                            continue;
+                        }
+                        fresh.push_back(&record);
+                    }
+                });
+
+                std::string journal;
+                for (const BatchRecord* record : fresh) {
+                    journal += itemRecord(record->isLost, record->item);
+                }
+                return journal;
+            },
+            [&] {
+                store.write([&](ItemStore& current) {
+                    for (const BatchRecord* record : fresh) {
+                        current.addItem(record->isLost, record->item);
+                    }
+                });
+            });
+        added = ok ? fresh.size() : 0;
+        if (!ok) {
+            return false;
+        }
+
+        // New found items still notify the standing queries
+        bool subscribed;
+        {
+            std::lock_guard<std::mutex> lock(subscribersMutex);
+            subscribed = !subscribers.empty();
+        }
+        if (subscribed) {
+            for (const BatchRecord* record : fresh) {
+                if (!record->isLost) {
+                    notifyStandingQueries(record->item.id);
+                }
+            }
+        }
+        return true;
+    }
+
+    // A parsed search request
+    struct BatchQuery {
+        bool searchFound = true;  // Which list is searched
+        ItemCategory category = ItemCategory::OTHER;
+        std::map<std::string, std::string> details;
+        std::string location;
+        std::string text;  // Free text matched against additional details
+        std::string eventTime;
+        bool archived = false;  // Search the resolved-item archive instead
+        SearchOptions options;
+    };
+
+    // Parse a JSON search request:
+    //   {"type":"found","category":"Bag","details":{"color":"black"},
+    //    "location":"...","text":"...","eventTime":"2024-05-01 14:30",
+    //    "windowDays":30,"archived":false,"limit":10,"offset":0,"minScore":1}
+    // "type" names the list searched; "windowDays" 0 turns off the time
+    // window around eventTime; "archived" searches resolved items instead
+    // of open ones. "limit" and "offset" are capped at MAX_SEARCH_LIMIT and
+    // MAX_SEARCH_OFFSET. Returns an error message or "".
+    std::string parseQueryJson(std::string_view json, BatchQuery& result) {
+        std::string type;
+        std::string categoryName;
+
+        JsonReader reader(json);
+        bool ok = reader.readObject([&](const std::string& key) {
+            long long number = 0;
+            if (key == "type") {
+                return reader.readString(type);
+            } else if (key == "category") {
+                return reader.readString(categoryName);
+            } else if (key == "location") {
+                return reader.readString(result.location);
+            } else if (key == "text") {
+                return reader.readString(result.text);
+            } else if (key == "eventTime") {
+                return reader.readString(result.eventTime);
+            } else if (key == "archived") {
+                return reader.readBool(result.archived);
+            } else if (key == "details") {
+                return reader.readObject([&](const std::string& detailKey) {
+                    return reader.readString(result.details[detailKey]);
+                });
+            } else if (key == "limit" || key == "offset" || key == "minScore" || key == "windowDays") {
+                if (!reader.readInteger(number) || number < 0) {
+                    return false;
+                }
+                if (key == "limit") {
+                    result.options.limit = static_cast<size_t>(std::min(number, MAX_SEARCH_LIMIT));
+                } else if (key == "offset") {
+                    result.options.offset = static_cast<size_t>(std::min(number, MAX_SEARCH_OFFSET));
+                } else if (key == "minScore") {
+                    result.options.minScore = static_cast<int>(std::min<long long>(number, std::numeric_limits<int>::max()));
+                } else {
+                    result.options.windowMinutes = std::min<long long>(number, 1000000) * 24 * 60;
+                }
+                return true;
+            }
+            return reader.skipValue();
+        });
+
+        if (!ok || !reader.atEnd()) {
+            return "malformed JSON near offset " + std::to_string(reader.position());
+        }
+        if (type != "lost" && type != "found") {
+            return "type must be \"lost\" or \"found\"";
+        }
+        if (!result.eventTime.empty() && parseEventMinute(result.eventTime) == NO_EVENT_TIME) {
+            return "eventTime must be YYYY-MM-DD HH:MM";
+        }
+        if (!findCategory(categoryName, result.category)) {
+            return "unknown category \"" + categoryName + "\"";
+        }
+
+        result.searchFound = (type == "found");
+        return "";
+    }
+
+    // Write `"total":N,"matches":[...]` for a search request
+    void writeQueryResults(std::ostream& out, const BatchQuery& request) const {
+        auto write = [&](const ItemStore& current) {
+            MatchQuery query = current.buildQuery(request.category, request.details, request.location,
+                                                  request.text, request.eventTime);
+            SearchOptions options = request.options;
+
+            size_t total = 0;
+            std::vector<SearchResult> results = current.findMatches(request.searchFound, query, options, &total);
+
+            const std::vector<Item>& searchIn = current.items(!request.searchFound);
+            out << "\"total\":" << total << ",\"matches\":[";
+            for (size_t i = 0; i < results.size(); i++) {
+                if (i > 0) {
+                    out << ",";
+                }
+                out << "{\"score\":" << results[i].score << ",\"item\":" << itemToJson(searchIn[results[i].slot]) << "}";
+            }
+            out << "]";
+        };
+
+        if (!request.archived) {
+            store.read(write);
+            return;
+        }
+
+        // Resolved items are in the archive, or still in the store if they
+        // were resolved since startup. Take the top offset + limit of each
+        // and merge; on equal scores the archive's (older) items come first.
+        SearchOptions options = request.options;
+        options.openOnly = false;
+        options.offset = 0;
+        options.limit = request.options.limit > SIZE_MAX - request.options.offset
+                            ? SIZE_MAX : request.options.offset + request.options.limit;
+
+        std::vector<std::pair<int, Item>> hits;
+        size_t total = 0;
+        auto searchTier = [&](const ItemStore& tier, const SearchOptions& tierOptions) {
+            MatchQuery query = tier.buildQuery(request.category, request.details, request.location,
+                                               request.text, request.eventTime);
+            size_t tierTotal = 0;
+            const std::vector<Item>& searchIn = tier.items(!request.searchFound);
+            for (const SearchResult& result : tier.findMatches(request.searchFound, query, tierOptions, &tierTotal)) {
+                hits.emplace_back(result.score, searchIn[result.slot]);
+            }
+            total += tierTotal;
+        };
+        searchTier(*archiveStore(), options);
+        SearchOptions resolvedOptions = options;
+        resolvedOptions.resolvedOnly = true;
+        store.read([&](const ItemStore& current) {
+            searchTier(current, resolvedOptions);
+        });
+        std::stable_sort(hits.begin(), hits.end(),
+                         [](const std::pair<int, Item>& a, const std::pair<int, Item>& b) {
+                             return a.first > b.first;
+                         });
+
+        out << "\"total\":" << total << ",\"matches\":[";
+        const size_t end = std::min(hits.size(), options.limit);
+        for (size_t i = request.options.offset; i < end; i++) {
+            if (i > request.options.offset) {
+                out << ",";
+            }
+            out << "{\"score\":" << hits[i].first << ",\"item\":" << itemToJson(hits[i].second) << "}";
+        }
+        out << "]";
+    }
+
+public:
+    // Constructor
+    LostFoundBot() {
+        initDataStorage();
+    }
+
+    // Destructor
+    ~LostFoundBot() {
+        closeJournal();
+    }
+
+    // Start the bot and display the main menu
+    void start() {
+        bool running = true;
+
+        while (running) {
+            std::cout << "\n===== LOST & FOUND BOT =====\n"
+                      << "1. Report a lost item\n"
+                      << "2. Report a found item\n"
+                      << "3. Search for items\n"
+                      << "4. Re-match all open items\n"
+                      << "5. Resolve an item (close/claim/match)\n"
+                      << "6. Exit\n"
+                      << "Enter your choice: ";
+
+            int choice = getIntInput("", 1, 6);
+
+            switch (choice) {
+                case 1:
+                    reportLostItem();
+                    break;
+                case 2:
+                    reportFoundItem();
+                    break;
+                case 3:
+                    searchItems();
+                    break;
+                case 4:
+                    rematchAllItems();
+                    break;
+                case 5:
+                    resolveItemMenu();
+                    break;
+                case 6:
+                    running = false;
+                    std::cout << "Thank you for using Lost & Found Bot. Goodbye!" << std::endl;
+                    break;
+            }
+        }
+    }
+
+    // Report a lost item
+    void reportLostItem() {
+        std::cout << "\n===== REPORT A LOST ITEM =====" << std::endl;
+
+        // Get user information
+        std::string reporterName = getInput("Enter your name: ");
+        std::string contactInfo = getInput("Enter your contact (phone/email): ");
+
+        // Get item category
+        ItemCategory category = getItemCategory();
+
+        // Get when the item was lost
+        std::string lostTime = getDateTime("When did you lose the item?");
+
+        // Get location where item was lost
+        std::string location = getLocation();
+
+        // Get item details based on category
+        std::map<std::string, std::string> itemDetails = getItemDetails(category);
+
+        // Get additional description
+        std::string additionalDetails = getInput("Please provide any additional details about the item: ");
+
+        // Save to storage
+        if (!saveLostItem(reporterName, contactInfo, category, lostTime, location,
+                          itemDetails, additionalDetails)) {
+            std::cout << "Could not save the report. Please try again." << std::endl;
+            return;
+        }
+
+        std::cout << "Lost item report submitted successfully!" << std::endl;
+
+        // Check for potential matches
+        searchForMatches(true, category, itemDetails, additionalDetails, lostTime);
+    }
+
+    // Report a found item
+    void reportFoundItem() {
+        std::cout << "\n===== REPORT A FOUND ITEM =====" << std::endl;
+
+        // Get finder information
+        std::string finderName = getInput("Enter your name: ");
+        std::string contactInfo = getInput("Enter your contact (phone/email): ");
+
+        // Get item category
+        ItemCategory category = getItemCategory();
+
+        // Get when the item was found
+        std::string foundTime = getDateTime("When did you find the item?");
+
+        // Get location where item was found
+        std::string location = getLocation();
+
+        // Get item details based on category
+        std::map<std::string, std::string> itemDetails = getItemDetails(category);
+
+        // Get additional description
+        std::string additionalDetails = getInput("Please provide any additional details about the item: ");
+
+        // Save to storage
+        std::vector<std::pair<Item, int>> notified;
+        if (!saveFoundItem(finderName, contactInfo, category, foundTime, location,
+                           itemDetails, additionalDetails, notified)) {
+            std::cout << "Could not save the report. Please try again." << std::endl;
+            return;
+        }
+
+        std::cout << "Found item report submitted successfully!" << std::endl;
+        if (!notified.empty()) {
+            std::cout << notified.size() << " owner" << (notified.size() == 1 ? " has" : "s have")
+                      << " been notified of a likely match." << std::endl;
+        }
+
+        // Check for potential matches
+        searchForMatches(false, category, itemDetails, additionalDetails, foundTime);
+    }
+
+    // Close, claim or match items by id
+    void resolveItemMenu() {
+        std::cout << "\n===== RESOLVE AN ITEM =====\n"
+                  << "1. Close an item (returned or withdrawn)\n"
+                  << "2. Claim a found item\n"
+                  << "3. Match a lost item with a found item\n";
+        int choice = getIntInput("Enter your choice: ", 1, 3);
+
+        ResolveError error;
+        if (choice == 3) {
+            std::string lostId = getInput("Enter the lost item ID: ");
+            std::string foundId = getInput("Enter the found item ID: ");
+            error = matchItems(lostId, foundId);
+        } else {
+            std::string id = getInput("Enter the item ID: ");
+            error = resolveItem(id, ItemStatus::CLOSED, choice == 2);
+        }
+
+        if (error == ResolveError::NONE) {
+            std::cout << "Item status updated." << std::endl;
+        } else {
+            std::cout << "Could not update: " << resolveErrorText(error) << "." << std::endl;
+        }
+    }
+
+    // Re-match every open lost item against the open found items and
+    // show the ranked table
+    void rematchAllItems() {
+        std::cout << "\n===== RE-MATCH ALL OPEN ITEMS =====" << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<MatchPair> table = runBulkMatching(10, 3);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::string filename = DATA_DIR + "/match_table.csv";
+        saveMatchTable(filename, table);
+
+        std::cout << table.size() << " candidate pairs in " << std::fixed << std::setprecision(3)
+                  << seconds << " s (full table written to " << filename << ")" << std::endl;
+
+        const size_t shown = std::min<size_t>(table.size(), 20);
+        store.read([&](const ItemStore& current) {
+            for (size_t i = 0; i < shown; i++) {
+                const Item& lost = current.lostItems[table[i].lostSlot];
+                const Item& found = current.foundItems[table[i].foundSlot];
+                std::cout << std::setw(3) << (i + 1) << ". Score " << std::setw(3) << table[i].score
+                          << "  " << categoryName(lost.category)
+                          << "  lost " << lost.id << " (" << lost.location << ")"
+                          << "  found " << found.id << " (" << found.location << ")" << std::endl;
+            }
+        });
+    }
+
+    // Search for items
+    void searchItems() {
+        std::cout << "\n===== SEARCH FOR ITEMS =====" << std::endl;
+        std::cout << "1. Search for lost items\n"
+                  << "2. Search for found items\n"
+                  << "3. Back to main menu" << std::endl;
+
+        int choice = getIntInput("Enter your choice: ", 1, 3);
+
+        if (choice == 3) {
+            return;
+        }
+
+        bool searchingLost = (choice == 2); // If looking for found items, we search lost items
+
+        // Get search criteria
+        ItemCategory category = getItemCategory();
+
+        // Get item details based on category for searching
+        std::map<std::string, std::string> searchDetails = getItemDetails(category);
+
+        // Free text is matched against reporters' additional details
+        std::string text = getInput("Any identifying marks or words to look for (optional): ");
+
+        // Search for potential matches
+        searchForMatches(searchingLost, category, searchDetails, text);
+    }
+
+    // Ingest a batch of items from NDJSON (one item object per line, with
+    // "type": "lost"|"found") or CSV (header row naming the columns). Bad
+    // records are reported on stderr and skipped; a summary line is written
+    // to out as JSON. Returns the number of rejected records.
+    size_t ingestBatch(std::istream& in, const std::string& format, std::ostream& out) {
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string content = buffer.str();
+
+        std::vector<BatchRecord> records;
+        size_t errors = 0;
+        auto reject = [&](size_t lineNumber, const std::string& message) {
+            std::cerr << "Record " << lineNumber << ": " << message << std::endl;
+            errors++;
+        };
+
+        if (format == "csv") {
+            std::vector<std::vector<std::string>> rows = parseCsv(content);
+            for (size_t i = 1; i < rows.size(); i++) {
+                BatchRecord record;
+                std::string error = parseCsvRecord(rows[0], rows[i], record);
+                if (error.empty()) {
+                    records.push_back(std::move(record));
+                } else {
+                    reject(i + 1, error);
+                }
+            }
+        } else {
+            std::istringstream lines(content);
+            std::string line;
+            size_t lineNumber = 0;
+            while (std::getline(lines, line)) {
+                lineNumber++;
+                if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                    continue;
+                }
+                BatchRecord record;
+                std::string error = parseNdjsonRecord(line, record);
+                if (error.empty()) {
+                    records.push_back(std::move(record));
+                } else {
+                    reject(lineNumber, error);
+                }
+            }
+        }
+
+        size_t added = 0;
+        size_t duplicates = 0;
+        if (!applyBatch(records, added, duplicates)) {
+            std::cerr << "Could not save the batch" << std::endl;
+            errors++;
+        }
+
+        out << "{\"ingested\":" << added << ",\"duplicates\":" << duplicates
+            << ",\"errors\":" << errors << "}" << std::endl;
+        return errors;
+    }
+
+    // Answer NDJSON queries, one per line (see parseQueryJson). Each
+    // answer is one NDJSON line. Returns the number of malformed queries.
+    size_t answerQueries(std::istream& in, std::ostream& out) {
+        std::string line;
+        size_t lineNumber = 0;
+        size_t errors = 0;
+
+        while (std::getline(in, line)) {
+            lineNumber++;
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+
+            BatchQuery query;
+            std::string error = parseQueryJson(line, query);
+            if (!error.empty()) {
+                out << "{\"query\":" << lineNumber << ",\"error\":\"" << escapeJsonString(error) << "\"}\n";
+                errors++;
+                continue;
+            }
+
+            out << "{\"query\":" << lineNumber << ",";
+            writeQueryResults(out, query);
+            out << "}\n";
+        }
+
+        out.flush();
+        return errors;
+    }
+
+    // Report an item from a JSON body (an ingest record without "type").
+    // The server assigns id, report time and status. Returns the response
+    // body and sets status to the HTTP status code.
+    std::string reportItemJson(bool isLost, std::string_view body, int& status) {
+        BatchRecord record;
+        std::string error = parseNdjsonRecord(body, record, isLost ? "lost" : "found");
+        if (error.empty() && record.isLost != isLost) {
+            error = "type does not match the endpoint";
+        }
+        if (!error.empty()) {
+            status = 400;
+            return "{\"error\":\"" + escapeJsonString(error) + "\"}";
+        }
+
+        record.item.set(&Item::id, generateId());
+        record.item.set(&Item::reportTime, getCurrentTimestamp());
+        record.item.status = ItemStatus::OPEN;
+        std::vector<std::pair<Item, int>> notified;
+        if (!storeItem(isLost, record.item, &notified)) {
+            status = 500;
+            return "{\"error\":\"could not save the report\"}";
+        }
+
+        // Same follow-up search the interactive report runs
+        BatchQuery request;
+        request.searchFound = isLost;
+        request.category = record.item.category;
+        for (const auto& detail : record.item.details) {
+            request.details.emplace(detail.first, detail.second);
+        }
+        request.location = record.item.location;
+        request.text = record.item.additionalInfo;
+        request.eventTime = record.item.eventTime;
+        request.options.limit = SEARCH_PAGE_SIZE;
+
+        std::ostringstream out;
+        out << "{\"id\":\"" << escapeJsonString(record.item.id) << "\",";
+        if (!isLost) {
+            // Lost reports whose standing query this item satisfied
+            out << "\"notified\":[";
+            for (size_t i = 0; i < notified.size(); i++) {
+                out << (i ? "," : "") << "{\"id\":\"" << escapeJsonString(notified[i].first.id)
+                    << "\",\"score\":" << notified[i].second << "}";
+            }
+            out << "],";
+        }
+        writeQueryResults(out, request);
+        out << "}";
+        status = 201;
+        return out.str();
+    }
+
+    // Run a search from a JSON body (see parseQueryJson)
+    std::string searchJson(std::string_view body, int& status) {
+        BatchQuery request;
+        std::string error = parseQueryJson(body, request);
+        if (!error.empty()) {
+            status = 400;
+            return "{\"error\":\"" + escapeJsonString(error) + "\"}";
+        }
+
+        std::ostringstream out;
+        out << "{";
+        writeQueryResults(out, request);
+        out << "}";
+        status = 200;
+        return out.str();
+    }
+
+    // Resolve items from a JSON body: {"id":...} for "close" and "claim",
+    // {"lostId":...,"foundId":...} for "match"
+    std::string resolveItemJson(const std::string& action, std::string_view body, int& status) {
+        std::string id, lostId, foundId;
+        JsonReader reader(body);
+        bool ok = reader.readObject([&](const std::string& key) {
+            if (key == "id") {
+                return reader.readString(id);
+            } else if (key == "lostId") {
+                return reader.readString(lostId);
+            } else if (key == "foundId") {
+                return reader.readString(foundId);
+            }
+            return reader.skipValue();
+        });
+        if (!ok || !reader.atEnd()) {
+            status = 400;
+            return "{\"error\":\"malformed JSON near offset " + std::to_string(reader.position()) + "\"}";
+        }
+
+        ResolveError error;
+        if (action == "match") {
+            if (lostId.empty() || foundId.empty()) {
+                status = 400;
+                return "{\"error\":\"lostId and foundId are required\"}";
+            }
+            error = matchItems(lostId, foundId);
+        } else {
+            if (id.empty()) {
+                status = 400;
+                return "{\"error\":\"id is required\"}";
+            }
+            error = resolveItem(id, ItemStatus::CLOSED, action == "claim");
+        }
+
+        switch (error) {
+            case ResolveError::NONE: status = 200; return "{\"status\":\"ok\"}";
+            case ResolveError::NOT_FOUND: status = 404; break;
+            case ResolveError::NOT_SAVED: status = 500; break;
+            default: status = 409; break;
+        }
+        return std::string("{\"error\":\"") + resolveErrorText(error) + "\"}";
+    }
+
+    // One item by id, from the store or the archive
+    std::string itemJson(std::string_view id, int& status) const {
+        std::string body;
+        auto find = [&](const ItemStore& current) {
+            bool isLost = false;
+            if (const Item* item = current.findItem(id, &isLost)) {
+                body = std::string("{\"type\":\"") + (isLost ? "lost" : "found") + "\",\"item\":" +
+                       itemToJson(*item) + "}";
+            }
+        };
+        store.read(find);
+        if (body.empty()) {
+            find(*archiveStore());
+        }
+
+        status = body.empty() ? 404 : 200;
+        return body.empty() ? "{\"error\":\"no item with that id\"}" : body;
+    }
+
+    // Items reported since a time ("YYYY-MM-DD HH:MM", UTC), oldest first
+    std::string itemsSinceJson(const std::string& since, size_t limit, int& status) const {
+        const int64_t sinceMinute = parseEventMinute(since);
+        if (sinceMinute == NO_EVENT_TIME) {
+            status = 400;
+            return "{\"error\":\"since must be YYYY-MM-DD HH:MM\"}";
+        }
+
+        std::string body = "{\"items\":[";
+        store.read([&](const ItemStore& current) {
+            bool first = true;
+            for (const auto& ref : current.itemsSince(sinceMinute * 60000, limit)) {
+                body += first ? "" : ",";
+                body += std::string("{\"type\":\"") + (ref.isLost ? "lost" : "found") + "\",\"item\":";
+                appendItemJson(body, current.items(ref.isLost)[ref.slot]);
+                body += "}";
+                first = false;
+            }
+        });
+        body += "]}";
+        status = 200;
+        return body;
+    }
+
+    // A count over the rollups: filters, an event-hour range [fromHour,
+    // toHour) and the dimensions to group by ("type", "category",
+    // "location", "building", "status", "day", "hour")
+    struct RollupQuery {
+        int list = -1;                                     // 1 lost, 0 found, -1 both
+        int category = -1;                                 // An ItemCategory, or -1 for all
+        int status = static_cast<int>(ItemStatus::OPEN);   // An ItemStatus, or -1 for all
+        int64_t fromHour = NO_EVENT_TIME;                  // NO_EVENT_TIME also counts undated items
+        int64_t toHour = INT64_MAX;
+        std::vector<std::string> groupBy;
+    };
+
+    // Parse rollup parameters (all optional):
+    //   type=lost|found|all, category=NAME, status=OPEN|CLOSED|MATCHED|all,
+    //   since=DATE, until=DATE (DATE is YYYY-MM-DD or YYYY-MM-DD HH:MM,
+    //   until is exclusive), days=N (event times in the last N days),
+    //   group=DIM[,DIM...]
+    // Returns an error message, or "" on success.
+    std::string parseRollupQuery(const std::map<std::string, std::string>& params, RollupQuery& query) {
+        static const std::unordered_set<std::string> dimensions = {"type", "category", "location", "building",
+                                                                   "status", "day", "hour"};
+        auto hourParam = [&](const std::string& value, int64_t& hour) {
+            int64_t minute = parseEventMinute(value.size() == 10 ? value + " 00:00" : value);
+            hour = Rollups::hourOf(minute);
+            return minute != NO_EVENT_TIME;
+        };
+
+        for (const auto& param : params) {
+            const std::string& value = param.second;
+            if (param.first == "type") {
+                if (value != "lost" && value != "found" && value != "all") {
+                    return "type must be lost, found or all";
+                }
+                query.list = value == "all" ? -1 : value == "lost";
+            } else if (param.first == "category") {
+                ItemCategory category;
+                if (!findCategory(value, category)) {
+                    return "unknown category \"" + value + "\"";
+                }
+                query.category = static_cast<int>(category);
+            } else if (param.first == "status") {
+                query.status = -2;
+                for (const auto& pair : statusNames) {
+                    if (pair.second == value) {
+                        query.status = static_cast<int>(pair.first);
+                    }
+                }
+                if (value == "all") {
+                    query.status = -1;
+                } else if (query.status == -2) {
+                    return "status must be OPEN, CLOSED, MATCHED or all";
+                }
+            } else if (param.first == "since") {
+                if (!hourParam(value, query.fromHour)) {
+                    return "since must be YYYY-MM-DD or YYYY-MM-DD HH:MM";
+                }
+            } else if (param.first == "until") {
+                if (!hourParam(value, query.toHour)) {
+                    return "until must be YYYY-MM-DD or YYYY-MM-DD HH:MM";
+                }
+            } else if (param.first == "days") {
+                char* end = nullptr;
+                long days = std::strtol(value.c_str(), &end, 10);
+                int64_t now = 0;
+                if (value.empty() || *end != '\0' || days <= 0 ||
+                    !hourParam(getCurrentTimestamp().substr(0, 16), now)) {
+                    return "days must be a positive number";
+                }
+                query.fromHour = now - days * 24 + 1;
+            } else if (param.first == "group") {
+                std::stringstream list(value);
+                std::string dimension;
+                while (std::getline(list, dimension, ',')) {
+                    if (!dimensions.count(dimension)) {
+                        return "cannot group by \"" + dimension + "\"";
+                    }
+                    query.groupBy.push_back(dimension);
+                }
+            } else {
+                return "unknown parameter \"" + param.first + "\"";
+            }
+        }
+        return "";
+    }
+
+    // Item counts per group, read from the rollups alone. Counts of
+    // resolved items include the archive's rollups.
+    std::map<std::vector<std::string>, size_t> rollupCounts(const RollupQuery& query) const {
+        const bool byTime = std::any_of(query.groupBy.begin(), query.groupBy.end(),
+                                        [](const std::string& dimension) { return dimension == "day" || dimension == "hour"; });
+        std::map<std::vector<std::string>, size_t> groups;
+        auto count = [&](const Rollups& rollups) {
+            for (const auto& series : rollups.series) {
+                const uint64_t key = series.first;
+                if ((query.list >= 0 && Rollups::isLost(key) != (query.list == 1)) ||
+                    (query.category >= 0 && Rollups::category(key) != static_cast<ItemCategory>(query.category)) ||
+                    (query.status >= 0 && Rollups::status(key) != static_cast<ItemStatus>(query.status))) {
+                    continue;
+                }
+
+                size_t total = 0;
+                const auto& hours = series.second;
+                for (auto it = hours.lower_bound(query.fromHour); it != hours.end() && it->first < query.toHour; ++it) {
+                    if (byTime) {
+                        groups[rollupGroup(query.groupBy, key, it->first)] += it->second;
+                    }
+                    total += it->second;
+                }
+                if (!byTime && total > 0) {
+                    groups[rollupGroup(query.groupBy, key, NO_EVENT_TIME)] += total;
+                }
+            }
+        };
+
+        store.read([&](const ItemStore& current) {
+            count(current.rollups);
+        });
+        if (query.status != static_cast<int>(ItemStatus::OPEN)) {
+            count(archiveRollups);
+        }
+        return groups;
+    }
+
+    // The group a series (and event hour) falls in
+    std::vector<std::string> rollupGroup(const std::vector<std::string>& groupBy, uint64_t key, int64_t hour) const {
+        const uint16_t locationId = Rollups::locationId(key);
+        const Location* location = locationId < predefinedLocations.size() ? &predefinedLocations[locationId] : nullptr;
+
+        std::vector<std::string> group;
+        for (const auto& dimension : groupBy) {
+            if (dimension == "type") {
+                group.push_back(Rollups::isLost(key) ? "lost" : "found");
+            } else if (dimension == "category") {
+                group.emplace_back(categoryName(Rollups::category(key)));
+            } else if (dimension == "location") {
+                group.push_back(location ? location->label() : "(unlisted)");
+            } else if (dimension == "building") {
+                group.push_back(!location ? "(unlisted)" : location->building.empty() ? location->label() : location->building);
+            } else if (dimension == "status") {
+                group.push_back(statusNames.at(Rollups::status(key)));
+            } else if (hour == NO_EVENT_TIME) {
+                group.push_back("(undated)");
+            } else {
+                std::time_t seconds = static_cast<std::time_t>(hour * 3600);
+                std::tm utc{};
+                ::gmtime_r(&seconds, &utc);
+                char buffer[32];
+                std::strftime(buffer, sizeof(buffer), dimension == "day" ? "%Y-%m-%d" : "%Y-%m-%d %H:00", &utc);
+                group.push_back(buffer);
+            }
+        }
+        return group;
+    }
+
+    // Rollup counts as JSON: {"total":N,"groups":[{"key":[...],"count":N}]}
+    std::string rollupJson(const std::map<std::string, std::string>& params, int& status) {
+        RollupQuery query;
+        std::string error = parseRollupQuery(params, query);
+        if (!error.empty()) {
+            status = 400;
+            return "{\"error\":\"" + escapeJsonString(error) + "\"}";
+        }
+
+        size_t total = 0;
+        std::string groups;
+        for (const auto& group : rollupCounts(query)) {
+            total += group.second;
+            groups += groups.empty() ? "{\"key\":[" : ",{\"key\":[";
+            for (size_t i = 0; i < group.first.size(); i++) {
+                groups += i ? ",\"" : "\"";
+                appendJsonEscaped(groups, group.first[i]);
+                groups += "\"";
+            }
+            groups += "],\"count\":" + std::to_string(group.second) + "}";
+        }
+
+        status = 200;
+        std::string body = "{\"total\":" + std::to_string(total);
+        if (!query.groupBy.empty()) {
+            body += ",\"groups\":[" + groups + "]";
+        }
+        return body + "}";
+    }
+
+    // Print open item counts by type, category and building for events in
+    // the last days days
+    void printRollupReport(int days, std::ostream& out) {
+        RollupQuery query;
+        parseRollupQuery({{"days", std::to_string(days)}, {"group", "type,category,building"}}, query);
+
+        out << "Open items by category and building, last " << days << " day" << (days == 1 ? "" : "s") << "\n";
+        size_t total = 0;
+        for (const auto& group : rollupCounts(query)) {
+            out << std::left << std::setw(7) << group.first[0] << std::setw(12) << group.first[1]
+                << std::setw(28) << group.first[2] << std::right << std::setw(6) << group.second << "\n";
+            total += group.second;
+        }
+        out << "Total: " << total << std::endl;
+    }
+
+    // Register a callback for standing-query matches: it gets the lost
+    // report, the found item and the score, on the reporting thread
+    void subscribe(MatchCallback callback) {
+        std::lock_guard<std::mutex> lock(subscribersMutex);
+        subscribers.push_back(std::move(callback));
+    }
+
+    // Instrumentation dumps for the /metrics endpoint
+    static bool metricsEnabled() {
+        return METRICS_ENABLED;
+    }
+
+    static std::string metricsText() {
+        return Metrics::prometheus();
+    }
+
+    static std::string metricsJson() {
+        return Metrics::json();
+    }
+
+    // Run the bulk re-matcher and return the top rows of the table
+    std::string matchTableJson(int minScore, size_t limit) {
+        std::vector<MatchPair> table = runBulkMatching(minScore, 3);
+
+        std::ostringstream out;
+        out << "{\"total\":" << table.size() << ",\"matches\":[";
+        store.read([&](const ItemStore& current) {
+            for (size_t i = 0; i < table.size() && i < limit; i++) {
+                if (i > 0) {
+                    out << ",";
+                }
+                out << "{\"score\":" << table[i].score
+                    << ",\"lost\":" << itemToJson(current.lostItems[table[i].lostSlot])
+                    << ",\"found\":" << itemToJson(current.foundItems[table[i].foundSlot]) << "}";
+            }
+        });
+        out << "]}";
+        return out.str();
+    }
+
+    // Synthetic locations for the benchmarks: 4 buildings x 5 floors x
+    // 8 rooms
+    static std::vector<Location> syntheticLocations() {
+        std::vector<Location> locations;
+        for (const char* building : {"Library", "Science Hall", "Student Center", "Gym"}) {
+            for (int floor = 1; floor <= 5; floor++) {
+                for (int room = 1; room <= 8; room++) {
+                    Location loc;
+                    loc.name = building;
+                    loc.building = building;
+                    loc.floor = std::to_string(floor);
+                    loc.roomNumber = std::to_string(floor * 100 + room);
+                    locations.push_back(std::move(loc));
+                }
+            }
+        }
+        return locations;
+    }
+
+    // Deterministic synthetic items across every category and its
+    // attributes: the same seed always gives the same items. Values are
+    // skewed toward the front of each word list, as popular brands and
+    // colors are in real reports.
+    static std::vector<Item> generateItems(size_t count, uint32_t seed) {
+        static const std::vector<std::string> colors = {
+            "black", "white", "silver", "blue", "grey", "red", "green", "gold", "pink", "brown"};
+        static const std::vector<std::string> brands = {
+            "Apple", "Samsung", "Lenovo", "Dell", "Sony", "Bose", "HP", "Google", "Asus", "Garmin", "Fitbit",
+            "Xiaomi"};
+        static const std::vector<std::string> words = {
+            "scratched", "sticker", "cracked", "corner", "leather", "worn", "blue", "strap", "zipper",
+            "keychain", "initials", "engraved", "pocket", "charger", "cable", "dent", "logo", "faded",
+            "small", "name", "tag", "card", "student", "front", "back", "side", "left", "near", "desk",
+            "window"};
+        static const std::vector<std::string> locations = [] {
+            std::vector<std::string> labels;
+            for (const auto& loc : syntheticLocations()) {
+                labels.push_back(loc.label());
+            }
+            return labels;
+        }();
+
+        std::mt19937 generator(seed);
+        auto pick = [&](size_t n) {
+            std::uniform_int_distribution<size_t> distribution(0, n - 1);
+            return std::min(distribution(generator), distribution(generator));
+        };
+        auto phrase = [&](size_t length) {
+            std::string text;
+            for (size_t i = 0; i < length; i++) {
+                text += (i > 0 ? " " : "") + words[pick(words.size())];
+            }
+            return text;
+        };
+
+        // Event times spread over 2024
+        const int64_t firstMinute = parseEventMinute("2024-01-01 00:00");
+        std::uniform_int_distribution<int64_t> minuteOfYear(0, 366 * 24 * 60 - 1);
+
+        // The generated items share one arena, as loaded items do
+        auto arena = std::make_shared<StringArena>();
+        std::vector<Item> items;
+        items.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            Item item;
+            item.text = arena;
+            item.id = arena->store("S" + std::to_string(seed) + "-" + std::to_string(i));
+            item.personName = arena->store("Reporter " + std::to_string(i));
+            item.contactInfo = arena->store("reporter" + std::to_string(i) + "@example.com");
+            item.category = static_cast<ItemCategory>(generator() % CATEGORY_COUNT);
+
+            std::time_t eventSeconds = static_cast<std::time_t>((firstMinute + minuteOfYear(generator)) * 60);
+            std::tm utc{};
+            ::gmtime_r(&eventSeconds, &utc);
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M", &utc);
+            item.eventTime = arena->store(buffer);
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:00", &utc);
+            item.reportTime = arena->store(buffer);
+
+            // Mostly predefined locations, some free text
+            item.location = arena->store(generator() % 10 != 0 ? locations[pick(locations.size())]
+                                                               : "Near entrance " + std::to_string(generator() % 50));
+
+            for (const auto& attribute : categorySchema(item.category)) {
+                if (generator() % 8 == 0) {
+                    continue;  // Reporters leave some details blank
+                }
+                std::string value;
+                if (attribute == "color") {
+                    value = colors[pick(colors.size())];
+                } else if (attribute == "brand") {
+                    value = brands[pick(brands.size())];
+                } else if (attribute == "model") {
+                    value = "Model " + std::to_string(pick(200));
+                } else if (attribute.rfind("has_", 0) == 0) {
+                    value = generator() % 2 ? "yes" : "no";
+                } else if (attribute == "wired_wireless") {
+                    value = generator() % 3 ? "wireless" : "wired";
+                } else if (attribute == "size" || attribute == "screen_size") {
+                    static const std::vector<std::string> sizes = {"small", "medium", "large"};
+                    value = sizes[pick(sizes.size())];
+                } else {
+                    value = phrase(2);
+                }
+                item.details.set(arena->store(attribute), arena->store(value));
+            }
+
+            item.additionalInfo = arena->store(phrase(4 + generator() % 6));
+            item.status = ItemStatus::OPEN;
+            items.push_back(std::move(item));
+        }
+        return items;
+    }
+
+    // One benchmark result line: total time, and latency percentiles when
+    // individual operations were timed (microseconds, sorted in place)
+    static void writeBenchResult(std::ostream& out, const std::string& name, size_t itemCount, size_t ops,
+                                 double seconds, std::vector<double> latencies = {}, size_t bytes = 0) {
+        out << "{\"benchmark\":\"" << name << "\",\"items\":" << itemCount << ",\"ops\":" << ops
+            << std::fixed << std::setprecision(6) << ",\"seconds\":" << seconds
+            << std::setprecision(1) << ",\"opsPerSecond\":" << (seconds > 0 ? ops / seconds : 0.0);
+        if (bytes > 0) {
+            out << ",\"bytes\":" << bytes << ",\"mibPerSecond\":"
+                << (seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0);
+        }
+        if (!latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) {
+                return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))];
+            };
+            out << std::setprecision(2) << ",\"p50Us\":" << percentile(0.50) << ",\"p99Us\":" << percentile(0.99)
+                << ",\"maxUs\":" << latencies.back();
+        }
+        out << "}" << std::endl;
+        out.unsetf(std::ios::floatfield);
+    }
+
+    // Benchmark suite over synthetic data, one NDJSON result line per
+    // benchmark and size on out. Static, so it needs no bot and never
+    // touches the live store or the data directory. Benchmarks:
+    //   ingest       add items to an empty store one at a time
+    //   save_json    saveItemsToFile
+    //   save_snap    binary snapshot write
+    //   load_json    loadItemsFromFile
+    //   load_snap    map the snapshot and materialize every item
+    //   search       findMatches for reports like the stored items
+    //   search_text  findMatches on free text alone
+    static void runBenchmarks(const std::vector<size_t>& sizes, std::ostream& out) {
+        using Clock = std::chrono::steady_clock;
+        auto secondsSince = [](Clock::time_point start) {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        };
+        auto microsSince = [](Clock::time_point start) {
+            return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        };
+
+        const std::vector<Location> locations = syntheticLocations();
+        const size_t QUERY_COUNT = 2000;
+        std::string filename = (std::filesystem::temp_directory_path() /
+                                ("lostfound_bench_" + std::to_string(::getpid()) + ".json")).string();
+        std::string snapshotFilename = filename + ".snap";
+
+        for (size_t itemCount : sizes) {
+            std::vector<Item> items = generateItems(itemCount, 1);
+
+            std::vector<double> latencies;
+            latencies.reserve(itemCount);
+            ItemStore bench;
+            bench.locations.build(locations);
+            auto start = Clock::now();
+            for (const auto& item : items) {
+                auto opStart = Clock::now();
+                bench.addItem(false, item);
+                latencies.push_back(microsSince(opStart));
+            }
+            writeBenchResult(out, "ingest", itemCount, itemCount, secondsSince(start), std::move(latencies));
+
+            start = Clock::now();
+            saveItemsToFile(filename, items);
+            writeBenchResult(out, "save_json", itemCount, itemCount, secondsSince(start), {},
+                             std::filesystem::file_size(filename));
+
+            start = Clock::now();
+            saveBinarySnapshot(snapshotFilename, items);
+            writeBenchResult(out, "save_snap", itemCount, itemCount, secondsSince(start), {},
+                             std::filesystem::file_size(snapshotFilename));
+
+            std::vector<Item> loaded;
+            start = Clock::now();
+            loadItemsFromFile(filename, loaded);
+            writeBenchResult(out, "load_json", itemCount, loaded.size(), secondsSince(start), {},
+                             std::filesystem::file_size(filename));
+            loaded.clear();
+            loaded.shrink_to_fit();
+
+            start = Clock::now();
+            MappedSnapshot snapshot;
+            snapshot.open(snapshotFilename);
+            snapshot.readItems(loaded);
+            writeBenchResult(out, "load_snap", itemCount, loaded.size(), secondsSince(start), {},
+                             std::filesystem::file_size(snapshotFilename));
+            snapshot.close();
+            loaded.clear();
+            loaded.shrink_to_fit();
+            std::filesystem::remove(filename);
+            std::filesystem::remove(snapshotFilename);
+
+            // Queries are lost reports drawn from a different seed
+            std::vector<Item> reports = generateItems(QUERY_COUNT, 2);
+            std::vector<MatchQuery> queries;
+            std::vector<MatchQuery> textQueries;
+            for (auto& report : reports) {
+                bench.normalizeItem(report);
+                queries.push_back(bench.queryFromItem(report));
+                textQueries.push_back(bench.buildQuery(report.category, {}, {}, report.additionalInfo));
+            }
+
+            SearchOptions options;
+            options.limit = SEARCH_PAGE_SIZE;
+            for (const auto& job : {std::make_pair("search", &queries), std::make_pair("search_text", &textQueries)}) {
+                latencies.clear();
+                start = Clock::now();
+                for (const auto& query : *job.second) {
+                    auto opStart = Clock::now();
+                    size_t total = 0;
+                    bench.findMatches(true, query, options, &total);
+                    latencies.push_back(microsSince(opStart));
+                }
+                writeBenchResult(out, job.first, itemCount, job.second->size(), secondsSince(start),
+                                 std::move(latencies));
+            }
+        }
+    }
+};
+
+// Small string helpers for the HTTP server
+namespace LostFoundBotHttp {
+    inline std::string lower(std::string_view text) {
+        std::string result(text);
+        std::transform(result.begin(), result.end(), result.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return result;
+    }
+
+    inline std::string_view trim(std::string_view text) {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    inline std::string urlDecode(std::string_view text) {
+        std::string result;
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '+') {
+                result += ' ';
+            } else if (text[i] == '%' && i + 2 < text.size() &&
+                       std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                       std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+                result += static_cast<char>(std::stoi(std::string(text.substr(i + 1, 2)), nullptr, 16));
+                i += 2;
+            } else {
+                result += text[i];
+            }
+        }
+        return result;
+    }
+}
+
+/**
+ * Minimal embedded HTTP/1.1 server: a single epoll event loop over
+ * non-blocking sockets. The loop only moves bytes and parses requests;
+ * handlers run on a few worker threads, so a slow one (a bulk match, an
+ * fsync) never stalls the other connections. Connections are kept alive
+ * and pipelined requests are answered in order. Request bodies need a
+ * Content-Length.
+ */
+class HttpServer {
+public:
+    struct Request {
+        std::string method;
+        std::string path;
+        std::map<std::string, std::string> query;  // Decoded query string
+        std::string body;
+    };
+
+    struct Response {
+        int status = 200;
+        std::string contentType = "application/json";
+        std::string body;
+    };
+
+    using Handler = std::function<Response(const Request&)>;
+
+    explicit HttpServer(Handler handler) : handler(std::move(handler)) {
+        for (size_t i = 0; i < HANDLER_THREADS; i++) {
+            handlerThreads.emplace_back(&HttpServer::runHandlers, this);
+        }
+    }
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    // Waits for running handlers; queued requests are dropped
+    ~HttpServer() {
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            handlersStopping = true;
+        }
+        jobsCv.notify_all();
+        for (auto& thread : handlerThreads) {
+            thread.join();
+        }
+
+        for (const auto& connection : connections) {
+            ::close(connection.first);
+        }
+        if (listenFd >= 0) {
+            ::close(listenFd);
+        }
+        if (epollFd >= 0) {
+            ::close(epollFd);
+        }
+        if (wakeFd >= 0) {
+            ::close(wakeFd);
+        }
+    }
+
+    // Bind and listen (port 0 picks a free port, see port())
+    bool listen(const std::string& address, uint16_t port) {
+        listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) {
+            std::cerr << "Failed to create socket: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        // SO_REUSEPORT lets several event loops share one port
+        int enable = 1;
+        ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        if (::inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+            std::cerr << "Invalid bind address: " << address << std::endl;
+            return false;
+        }
+
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listenFd, SOMAXCONN) != 0) {
+            std::cerr << "Failed to listen on " << address << ":" << port << ": "
+                      << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        socklen_t length = sizeof(addr);
+        ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &length);
+        boundPort = ntohs(addr.sin_port);
+
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || wakeFd < 0) {
+            std::cerr << "Failed to create epoll instance: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return watch(listenFd, EPOLLIN, EPOLL_CTL_ADD) && watch(wakeFd, EPOLLIN, EPOLL_CTL_ADD);
+    }
+
+    uint16_t port() const {
+        return boundPort;
+    }
+
+    // Serve until stop() is called
+    void run() {
+        std::vector<epoll_event> events(256);
+
+        while (!stopping.load()) {
+            int count = ::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 200);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "epoll_wait failed: " << std::strerror(errno) << std::endl;
+                return;
+            }
+
+            for (int i = 0; i < count; i++) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptConnections();
+                    continue;
+                }
+                if (fd == wakeFd) {
+                    collectResponses();
+                    continue;
+                }
+
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    closeConnection(fd);
+                    continue;
+                }
+                if ((events[i].events & EPOLLIN) && !readFrom(fd)) {
+                    continue;
+                }
+                if (events[i].events & EPOLLOUT) {
+                    writeTo(fd);
+                }
+            }
+        }
+    }
+
+    // Ask run() to return; safe to call from a signal handler
+    void stop() {
+        stopping.store(true);
+    }
+
+private:
+    static constexpr size_t MAX_HEADER_BYTES = 16 * 1024;
+    static constexpr size_t MAX_BODY_BYTES = 1024 * 1024;
+    static constexpr size_t HANDLER_THREADS = 4;
+
+    // Input buffered per connection: room for one request of the largest
+    // allowed size. Reading stops while it is full.
+    static constexpr size_t MAX_INPUT_BYTES = MAX_HEADER_BYTES + 4 + MAX_BODY_BYTES;
+
+    // Requests a connection may have unanswered; further pipelined ones
+    // wait in its input buffer
+    static constexpr uint64_t MAX_PIPELINED_REQUESTS = 16;
+
+    struct Connection {
+        uint64_t id = 0;  // Tells apart connections that reuse an fd
+        std::string in;
+        std::string out;
+        uint64_t nextSeq = 0;     // Number given to the next request
+        uint64_t flushedSeq = 0;  // Responses before this one are in out
+        std::map<uint64_t, std::string> finished;  // Waiting on earlier responses
+        bool closeAfterWrite = false;
+        uint32_t events = EPOLLIN;  // Registered with epoll
+    };
+
+    // A parsed request on its way to a handler thread, and its answer on
+    // the way back (as response bytes)
+    struct Job {
+        int fd;
+        uint64_t connectionId;
+        uint64_t seq;
+        Request request;
+        bool keepAlive;
+    };
+
+    struct Completion {
+        int fd;
+        uint64_t connectionId;
+        uint64_t seq;
+        std::string bytes;
+    };
+
+    Handler handler;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;  // Handler threads signal finished responses here
+    uint16_t boundPort = 0;
+    std::atomic<bool> stopping{false};
+    std::unordered_map<int, Connection> connections;
+    uint64_t nextConnectionId = 1;
+
+    std::vector<std::thread> handlerThreads;
+    std::mutex jobsMutex;
+    std::condition_variable jobsCv;
+    std::deque<Job> jobs;
+    bool handlersStopping = false;
+    std::mutex completionsMutex;
+    std::vector<Completion> completions;
+
+    // Handler thread: run queued requests and hand the responses back to
+    // the event loop
+    void runHandlers() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(jobsMutex);
+                jobsCv.wait(lock, [this] { return handlersStopping || !jobs.empty(); });
+                if (handlersStopping) {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            Response response;
+            try {
+                response = handler(job.request);
+            } catch (const std::exception&) {
+                response.status = 500;
+                response.body = "{\"error\":\"internal error\"}";
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(completionsMutex);
+                completions.push_back({job.fd, job.connectionId, job.seq, formatResponse(response, job.keepAlive)});
+            }
+            const uint64_t one = 1;
+            ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    }
+
+    // Event loop: file the responses the handlers finished under their
+    // connections (unless closed meanwhile) and send what is in order
+    void collectResponses() {
+        uint64_t count;
+        ssize_t ignored = ::read(wakeFd, &count, sizeof(count));
+        (void)ignored;
+
+        std::vector<Completion> done;
+        {
+            std::lock_guard<std::mutex> lock(completionsMutex);
+            done.swap(completions);
+        }
+        for (auto& completion : done) {
+            auto it = connections.find(completion.fd);
+            if (it == connections.end() || it->second.id != completion.connectionId) {
+                continue;
+            }
+            finish(it->second, completion.seq, std::move(completion.bytes));
+            writeTo(completion.fd);
+        }
+    }
+
+    // Record the response to request seq and move every response that is
+    // now in order to the output buffer
+    static void finish(Connection& connection, uint64_t seq, std::string bytes) {
+        connection.finished.emplace(seq, std::move(bytes));
+        auto it = connection.finished.begin();
+        while (it != connection.finished.end() && it->first == connection.flushedSeq) {
+            connection.out += it->second;
+            connection.flushedSeq++;
+            it = connection.finished.erase(it);
+        }
+    }
+
+    bool watch(int fd, uint32_t events, int operation) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        return ::epoll_ctl(epollFd, operation, fd, &event) == 0;
+    }
+
+    void acceptConnections() {
+        while (true) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                return;  // EAGAIN: nothing more to accept
+            }
+
+            int enable = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            if (!watch(fd, EPOLLIN, EPOLL_CTL_ADD)) {
+                ::close(fd);
+                continue;
+            }
+            Connection connection;
+            connection.id = nextConnectionId++;
+            connections.emplace(fd, std::move(connection));
+        }
+    }
+
+    void closeConnection(int fd) {
+        ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        connections.erase(fd);
+    }
+
+    // Read what is available, up to a full input buffer, and answer the
+    // complete requests in it. Nothing more is read from a connection that
+    // is closing. Returns false if the connection was closed.
+    bool readFrom(int fd) {
+        Connection& connection = connections[fd];
+        char buffer[64 * 1024];
+
+        while (!connection.closeAfterWrite && connection.in.size() < MAX_INPUT_BYTES) {
+            const size_t room = std::min(sizeof(buffer), MAX_INPUT_BYTES - connection.in.size());
+            ssize_t received = ::recv(fd, buffer, room, 0);
+            if (received > 0) {
+                connection.in.append(buffer, received);
+                processRequests(fd, connection);
+                continue;
+            }
+            if (received == 0) {
+                // Peer closed; flush what is already queued, then close
+                connection.closeAfterWrite = true;
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            closeConnection(fd);
+            return false;
+        }
+
+        processRequests(fd, connection);
+        return writeTo(fd);
+    }
+
+    // Send queued output. Returns false if the connection was closed.
+    bool writeTo(int fd) {
+        Connection& connection = connections[fd];
+
+        size_t sent = 0;
+        while (sent < connection.out.size()) {
+            ssize_t result = ::send(fd, connection.out.data() + sent, connection.out.size() - sent, MSG_NOSIGNAL);
+            if (result > 0) {
+                sent += result;
+            } else if (result < 0 && errno == EINTR) {
+                continue;
+            } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                closeConnection(fd);
+                return false;
+            }
+        }
+        connection.out.erase(0, sent);
+
+        // Requests held back while earlier ones were answered go next
+        if (connection.out.empty() && !connection.in.empty()) {
+            processRequests(fd, connection);
+        }
+
+        // Close once every answered request has been sent
+        if (connection.out.empty() && connection.closeAfterWrite && connection.flushedSeq == connection.nextSeq) {
+            closeConnection(fd);
+            return false;
+        }
+
+        // Only ask for EPOLLOUT while output is pending. A closed read side
+        // stays readable, and so does a socket left unread while closing or
+        // with a full input buffer, so EPOLLIN is dropped then to stop the
+        // loop from spinning; TCP holds off the client meanwhile.
+        const bool wantRead = !connection.closeAfterWrite && connection.in.size() < MAX_INPUT_BYTES;
+        const bool wantWrite = !connection.out.empty();
+        const uint32_t events = (wantRead ? uint32_t(EPOLLIN) : 0u) | (wantWrite ? uint32_t(EPOLLOUT) : 0u);
+        if (events != connection.events) {
+            watch(fd, events, EPOLL_CTL_MOD);
+            connection.events = events;
+        }
+        return true;
+    }
+
+    // A connection takes no new requests while MAX_PIPELINED_REQUESTS are
+    // unanswered or earlier responses still wait for the socket
+    static bool isBusy(const Connection& connection) {
+        return connection.nextSeq - connection.flushedSeq >= MAX_PIPELINED_REQUESTS || !connection.out.empty();
+    }
+
+    // Parse complete requests at the front of the input buffer and queue
+    // them for the handler threads, until the connection is busy
+    void processRequests(int fd, Connection& connection) {
+        while ((!connection.closeAfterWrite || !connection.in.empty()) && !isBusy(connection)) {
+            size_t headerEnd = connection.in.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) {
+                if (connection.in.size() > MAX_HEADER_BYTES) {
+                    queueError(connection, 431, "request header too large");
+                }
+                return;
+            }
+
+            Request request;
+            bool keepAlive = true;
+            size_t contentLength = 0;
+            std::string error;
+            int errorStatus = 400;
+
+            // Request line
+            std::string_view head(connection.in.data(), headerEnd);
+            size_t lineEnd = head.find("\r\n");
+            std::string_view requestLine = head.substr(0, lineEnd);
+            size_t firstSpace = requestLine.find(' ');
+            size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+            if (firstSpace == std::string_view::npos || secondSpace == std::string_view::npos) {
+                queueError(connection, 400, "malformed request line");
+                return;
+            }
+            request.method = std::string(requestLine.substr(0, firstSpace));
+            std::string_view target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+            std::string_view version = requestLine.substr(secondSpace + 1);
+            if (version == "HTTP/1.0") {
+                keepAlive = false;
+            } else if (version != "HTTP/1.1") {
+                queueError(connection, 505, "unsupported HTTP version");
+                return;
+            }
+
+            size_t queryStart = target.find('?');
+            request.path = std::string(target.substr(0, queryStart));
+            if (queryStart != std::string_view::npos) {
+                parseQueryString(target.substr(queryStart + 1), request.query);
+            }
+
+            // Headers
+            while (lineEnd != std::string_view::npos && lineEnd < head.size()) {
+                size_t next = head.find("\r\n", lineEnd + 2);
+                std::string_view line = head.substr(lineEnd + 2, next == std::string_view::npos
+                                                                     ? std::string_view::npos : next - lineEnd - 2);
+                lineEnd = next;
+
+                size_t colon = line.find(':');
+                if (colon == std::string_view::npos) {
+                    continue;
+                }
+                std::string name = LostFoundBotHttp::lower(line.substr(0, colon));
+                std::string value = LostFoundBotHttp::lower(LostFoundBotHttp::trim(line.substr(colon + 1)));
+
+                if (name == "content-length") {
+                    try {
+                        contentLength = std::stoul(value);
+                    } catch (const std::exception&) {
+                        error = "invalid Content-Length";
+                    }
+                } else if (name == "transfer-encoding" && value != "identity") {
+                    error = "chunked request bodies are not supported";
+                    errorStatus = 411;
+                } else if (name == "connection") {
+                    if (value == "close") {
+                        keepAlive = false;
+                    } else if (value == "keep-alive") {
+                        keepAlive = true;
+                    }
+                }
+            }
+
+            if (!error.empty()) {
+                queueError(connection, errorStatus, error);
+                return;
+            }
+            if (contentLength > MAX_BODY_BYTES) {
+                queueError(connection, 413, "request body too large");
+                return;
+            }
+
+            // Wait for the rest of the body
+            size_t bodyStart = headerEnd + 4;
+            if (connection.in.size() - bodyStart < contentLength) {
+                return;
+            }
+            request.body = connection.in.substr(bodyStart, contentLength);
+            connection.in.erase(0, bodyStart + contentLength);
+
+            {
+                std::lock_guard<std::mutex> lock(jobsMutex);
+                jobs.push_back({fd, connection.id, connection.nextSeq++, std::move(request), keepAlive});
+            }
+            jobsCv.notify_one();
+
+            if (!keepAlive) {
+                connection.closeAfterWrite = true;
+                connection.in.clear();
+                return;
+            }
+        }
+    }
+
+    // Answer with an error and close once it is sent
+    void queueError(Connection& connection, int status, const std::string& message) {
+        Response response;
+        response.status = status;
+        response.body = "{\"error\":\"" + message + "\"}";
+        finish(connection, connection.nextSeq++, formatResponse(response, false));
+        connection.closeAfterWrite = true;
+        connection.in.clear();
+    }
+
+    static std::string formatResponse(const Response& response, bool keepAlive) {
+        std::string out;
+        out += "HTTP/1.1 " + std::to_string(response.status) + " " + reasonPhrase(response.status) + "\r\n";
+        out += "Content-Type: " + response.contentType + "\r\n";
+        out += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+        out += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+        // The web frontend is served from a different origin
+        out += "Access-Control-Allow-Origin: *\r\n";
+        out += "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n";
+        out += "Access-Control-Allow-Headers: Content-Type\r\n\r\n";
+        out += response.body;
+        return out;
+    }
+
+    static const char* reasonPhrase(int status) {
+        switch (status) {
+            case 200: return "OK";
+            case 201: return "Created";
+            case 204: return "No Content";
+            case 400: return "Bad Request";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 409: return "Conflict";
+            case 411: return "Length Required";
+            case 413: return "Payload Too Large";
+            case 431: return "Request Header Fields Too Large";
+            case 505: return "HTTP Version Not Supported";
+            default: return status >= 500 ? "Internal Server Error" : "Error";
+        }
+    }
+
+    // Decode "a=1&b=x%20y" into a map
+    static void parseQueryString(std::string_view text, std::map<std::string, std::string>& query) {
+        while (!text.empty()) {
+            size_t amp = text.find('&');
+            std::string_view pair = text.substr(0, amp);
+            size_t equals = pair.find('=');
+            std::string key = LostFoundBotHttp::urlDecode(pair.substr(0, equals));
+            std::string value = equals == std::string_view::npos ? "" : LostFoundBotHttp::urlDecode(pair.substr(equals + 1));
+            if (!key.empty()) {
+                query[key] = value;
+            }
+            if (amp == std::string_view::npos) {
+                break;
+            }
+            text.remove_prefix(amp + 1);
+        }
+    }
+};
+
+// Route API requests to the bot:
+//   GET  /health
+//   POST /api/lost, /api/found   report an item (JSON body)
+//   POST /api/search             search (JSON body, see parseQueryJson)
+//   GET  /api/matches            bulk match table (?minScore=&limit=)
+//   POST /api/close, /api/claim  close an item / claim a found item ({"id"})
+//   POST /api/match              match a lost and a found item ({"lostId","foundId"})
+//   GET  /metrics                instrumentation, Prometheus text (?format=json for JSON)
+//   GET  /api/items/{id}         one item by id
+//   GET  /api/items?since=       items reported since a UTC time (&limit=)
+static HttpServer::Response routeApiRequest(LostFoundBot& bot, const HttpServer::Request& request) {
+    HttpServer::Response response;
+
+    if (request.method == "OPTIONS") {
+        response.status = 204;  // CORS preflight
+        return response;
+    }
+
+    auto expectMethod = [&](const char* method) {
+        if (request.method == method) {
+            return true;
+        }
+        response.status = 405;
+        response.body = "{\"error\":\"method not allowed\"}";
+        return false;
+    };
+
+    if (request.path == "/health") {
+        if (expectMethod("GET")) {
+            response.body = "{\"status\":\"ok\"}";
+        }
+    } else if (request.path == "/api/lost" || request.path == "/api/found") {
+        if (expectMethod("POST")) {
+            response.body = bot.reportItemJson(request.path == "/api/lost", request.body, response.status);
+        }
+    } else if (request.path == "/api/search") {
+        if (expectMethod("POST")) {
+            response.body = bot.searchJson(request.body, response.status);
+        }
+    } else if (request.path == "/api/close" || request.path == "/api/claim" || request.path == "/api/match") {
+        if (expectMethod("POST")) {
+            response.body = bot.resolveItemJson(request.path.substr(5), request.body, response.status);
+        }
+    } else if (request.path.rfind("/api/items/", 0) == 0) {
+        if (expectMethod("GET")) {
+            response.body = bot.itemJson(std::string_view(request.path).substr(11), response.status);
+        }
+    } else if (request.path == "/api/items") {
+        if (expectMethod("GET")) {
+            auto since = request.query.find("since");
+            auto limit = request.query.find("limit");
+            try {
+                response.body = bot.itemsSinceJson(since != request.query.end() ? since->second : "",
+                                                   limit != request.query.end() ? std::stoul(limit->second) : 100,
+                                                   response.status);
+            } catch (const std::exception&) {
+                response.status = 400;
+                response.body = "{\"error\":\"invalid limit\"}";
+            }
+        }
+    } else if (request.path == "/api/rollups") {
+        if (expectMethod("GET")) {
+            response.body = bot.rollupJson(request.query, response.status);
+        }
+    } else if (request.path == "/metrics") {
+        if (expectMethod("GET")) {
+            auto format = request.query.find("format");
+            if (!LostFoundBot::metricsEnabled()) {
+                response.status = 404;
+                response.body = "{\"error\":\"metrics are compiled out\"}";
+            } else if (format != request.query.end() && format->second == "json") {
+                response.body = LostFoundBot::metricsJson();
+            } else {
+                response.contentType = "text/plain; version=0.0.4";
+                response.body = LostFoundBot::metricsText();
+            }
+        }
+    } else if (request.path == "/api/matches") {
+        if (expectMethod("GET")) {
+            int minScore = 10;
+            size_t limit = 100;
+            try {
+                auto it = request.query.find("minScore");
+                if (it != request.query.end()) {
+                    minScore = std::stoi(it->second);
+                }
+                it = request.query.find("limit");
+                if (it != request.query.end()) {
+                    limit = std::stoul(it->second);
+                }
+                response.body = bot.matchTableJson(minScore, limit);
+            } catch (const std::exception&) {
+                response.status = 400;
+                response.body = "{\"error\":\"invalid minScore or limit\"}";
+            }
+        }
+    } else {
+        response.status = 404;
+        response.body = "{\"error\":\"not found\"}";
+    }
+
+    return response;
+}
+
+// Servers being run by --serve, for the signal handler
+static std::vector<std::unique_ptr<HttpServer>> activeServers;
+
+static void handleStopSignal(int) {
+    for (const auto& server : activeServers) {
+        server->stop();
+    }
+}
+
+// Print command line usage
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  (no options)                 interactive menu\n"
+              << "  --ingest FILE                ingest items from FILE ('-' for stdin)\n"
+              << "  --format ndjson|csv          ingest format (default: from extension, else ndjson)\n"
+              << "  --query FILE                 answer NDJSON queries from FILE ('-' for stdin)\n"
+              << "  --serve PORT [--bind ADDR] [--threads N]\n"
+              << "                               serve the HTTP API (default address 127.0.0.1,\n"
+              << "                               one event loop per thread, each with its own\n"
+              << "                               request handler threads)\n"
+              << "  --report [DAYS]              print open item counts by category and building\n"
+              << "                               for the last DAYS days (default 7)\n"
+              << "  --bench [N,N,...]            run the benchmark suite on N synthetic items\n"
+              << "                               (default 10000,100000,1000000); NDJSON results\n"
+              << "                               on stdout" << std::endl;
+}
+
+// Parse a command line number: all digits and within [min, max]
+static bool parseNumberArgument(const char* text, unsigned long min, unsigned long max, unsigned long& value) {
+    if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    errno = 0;
+    char* end = nullptr;
+    value = std::strtoul(text, &end, 10);
+    return errno == 0 && *end == '\0' && value >= min && value <= max;
+}
+
+int main(int argc, char* argv[]) {
+    // Benchmarks, on synthetic data only (the data directory is not touched)
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--bench") {
+        std::vector<size_t> sizes;
+        std::stringstream list(argc == 3 ? argv[2] : "10000,100000,1000000");
+        std::string size;
+        try {
+            while (std::getline(list, size, ',')) {
+                sizes.push_back(std::stoul(size));
+            }
+        } catch (const std::exception&) {
+            printUsage(argv[0]);
+            return 2;
+        }
+        LostFoundBot::runBenchmarks(sizes, std::cout);
+        return 0;
+    }
+
+    // Open item counts from the rollups
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--report") {
+        int days = 7;
+        try {
+            days = argc == 3 ? std::stoi(argv[2]) : 7;
+        } catch (const std::exception&) {
+            days = 0;
+        }
+        if (days <= 0) {
+            printUsage(argv[0]);
+            return 2;
+        }
+        LostFoundBot bot;
+        bot.printRollupReport(days, std::cout);
+        return 0;
+    }
+
+    // HTTP API server
+    if (argc >= 3 && std::string(argv[1]) == "--serve") {
+        std::string address = "127.0.0.1";
+        unsigned long port = 0;
+        unsigned long threads = 1;
+        if (!parseNumberArgument(argv[2], 0, 65535, port)) {
+            std::cerr << "Invalid port: " << argv[2] << " (expected 0-65535)" << std::endl;
+            return 2;
+        }
+        for (int i = 3; i < argc; i += 2) {
+            std::string arg = argv[i];
+            if (arg == "--bind" && i + 1 < argc) {
+                address = argv[i + 1];
+            } else if (arg == "--threads" && i + 1 < argc) {
+                if (!parseNumberArgument(argv[i + 1], 1, 256, threads)) {
+                    std::cerr << "Invalid thread count: " << argv[i + 1] << " (expected 1-256)" << std::endl;
+                    return 2;
+                }
+            } else {
+                printUsage(argv[0]);
+                return 2;
+            }
+        }
+
+        // Each thread runs its own event loop on the shared port; searches
+        // read the store concurrently and reports are serialized by it
+        LostFoundBot bot;
+        bot.subscribe([](const auto& lost, const auto& found, int score) {
+            std::ostringstream line;
+            line << "Match: lost " << lost.id << " <- found " << found.id << " (score " << score << ")\n";
+            std::cout << line.str() << std::flush;
+        });
+        for (size_t i = 0; i < threads; i++) {
+            auto server = std::make_unique<HttpServer>([&bot](const HttpServer::Request& request) {
+                return routeApiRequest(bot, request);
+            });
+            if (!server->listen(address, static_cast<uint16_t>(port))) {
+                return 1;
+            }
+            port = server->port();  // Later loops join the port the first one got
+            activeServers.push_back(std::move(server));
+        }
+
+        std::signal(SIGINT, handleStopSignal);
+        std::signal(SIGTERM, handleStopSignal);
+        std::signal(SIGPIPE, SIG_IGN);
+
+        std::cout << "Serving Lost & Found API on http://" << address << ":" << port
+                  << " (" << threads << " thread" << (threads == 1 ? "" : "s") << ")" << std::endl;
+
+        std::vector<std::thread> loops;
+        for (size_t i = 1; i < activeServers.size(); i++) {
+            loops.emplace_back([i] { activeServers[i]->run(); });
+        }
+        activeServers[0]->run();
+        for (auto& loop : loops) {
+            loop.join();
+        }
+        activeServers.clear();  // Joins the handler threads while the bot is still alive
+        return 0;
+    }
+
+    // Headless batch mode
+    if (argc > 1) {
+        std::string ingestFile;
+        std::string queryFile;
+        std::string format;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if ((arg == "--ingest" || arg == "--query" || arg == "--format") && i + 1 < argc) {
+                std::string value = argv[++i];
+                if (arg == "--ingest") {
+                    ingestFile = value;
+                } else if (arg == "--query") {
+                    queryFile = value;
+                } else {
+                    format = value;
+                }
+            } else {
+                printUsage(argv[0]);
+                return 2;
+            }
+        }
+
+        if ((ingestFile.empty() && queryFile.empty()) ||
+            (!format.empty() && format != "ndjson" && format != "csv") ||
+            (ingestFile == "-" && queryFile == "-")) {
+            printUsage(argv[0]);
+            return 2;
+        }
+
+        if (format.empty()) {
+            format = ingestFile.size() > 4 && ingestFile.compare(ingestFile.size() - 4, 4, ".csv") == 0
+                         ? "csv" : "ndjson";
+        }
+
+        LostFoundBot bot;
+        size_t errors = 0;
+
+        // Ingest first so the queries see the new items
+        for (const auto& job : {std::make_pair(true, ingestFile), std::make_pair(false, queryFile)}) {
+            if (job.second.empty()) {
+                continue;
+            }
+
+            std::ifstream file;
+            if (job.second != "-") {
+                file.open(job.second, std::ios::binary);
+                if (!file.is_open()) {
+                    std::cerr << "Failed to open file: " << job.second << std::endl;
+                    return 1;
+                }
+            }
+            std::istream& in = (job.second == "-") ? std::cin : file;
+
+            errors += job.first ? bot.ingestBatch(in, format, std::cout) : bot.answerQueries(in, std::cout);
+        }
+
+        return errors > 0 ? 1 : 0;
+    }
 
-int main() {
     std::cout << "Initializing Lost & Found Bot..." << std::endl;
 
     LostFoundBot bot;